@@ -0,0 +1,36 @@
+#include "decode_cache.h"
+
+#include "../mmu/mmu.h"
+#include "../pak/pak.h"
+
+DecodeCache::DecodeCache(Mmu& m) : mmu(m) { rom_banks.resize((mmu.pak.image->size() + 0x3FFF) / 0x4000); }
+
+DecodedOp* DecodeCache::slot(u16 pc) {
+    // Only HRAM is reachable during OAM DMA, fetches elsewhere see 0xFF
+    if (mmu.dma_active && pc < 0xFF80) return nullptr;
+
+    if (pc < 0x8000) {
+        if ((pc & 0x3FFF) >= 0x3FFE) return nullptr;
+
+        size_t offset = (mmu.memory_map[pc >> 12] - mmu.pak.image->data()) + (pc & 0x0FFF);
+        size_t bank_n = offset >> 14;
+        if (bank_n >= rom_banks.size()) return nullptr;
+
+        std::unique_ptr<Bank>& bank = rom_banks[bank_n];
+        if (!bank) {
+            bank = std::make_unique<Bank>();
+        }
+        return &(*bank)[offset & 0x3FFF];
+    } else if (pc >= 0xC000 && pc < 0xDFFE) {
+        return &wram[pc - 0xC000];
+    } else if (pc >= 0xFF80 && pc < 0xFFFD) {
+        return &hram[pc - 0xFF80];
+    }
+
+    return nullptr;
+}
+
+void DecodeCache::flush_ram() {
+    wram.fill(DecodedOp{});
+    hram.fill(DecodedOp{});
+}
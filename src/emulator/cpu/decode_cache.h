@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class Mmu;
+
+// One predecoded instruction: the opcode and up to two immediate bytes.
+// `valid` is cleared when the bytes it was decoded from may have changed.
+//
+// No handler pointer, a member function pointer is 16 bytes with GCC and
+// Clang and the table lookup is one load. No cycle sums over straight-line
+// runs either: a run still has to stop at every write and move the clock on
+// for every instruction, and what's left is about 2 instructions long.
+struct DecodedOp {
+    u8 valid;
+    u8 opcode;
+    u8 operand[2];
+};
+
+// Caches decoded instructions so Cpu::step doesn't have to go through
+// Mmu::read_u8 for the opcode and its immediates every time.
+//
+// ROM entries are keyed by offset into Pak::data, i.e. (ROM bank, PC), so they
+// survive MBC bank switches and never need flushing. WRAM and HRAM entries are
+// keyed by address and invalidated by Mmu::write_u8.
+class DecodeCache {
+   public:
+    Mmu& mmu;
+
+    DecodeCache(Mmu& m);
+
+    // Returns the cache slot for an instruction at `pc`, or nullptr if code at
+    // that address isn't cached (VRAM, ERAM, Echo RAM, IO, too close to the
+    // end of a region for the operands to be guaranteed to be in it, or
+    // outside HRAM while OAM DMA blocks the bus).
+    DecodedOp* slot(u16 pc);
+
+    inline void invalidate_wram(u16 addr) {
+        int i = addr & 0x1FFF;
+        for (int j = i; j >= 0 && j > i - 3; j--) {
+            wram[j].valid = 0;
+        }
+    }
+
+    inline void invalidate_hram(u16 addr) {
+        int i = addr - 0xFF80;
+        for (int j = i; j >= 0 && j > i - 3; j--) {
+            hram[j].valid = 0;
+        }
+    }
+
+    void flush_ram();
+
+   private:
+    using Bank = std::array<DecodedOp, 0x4000>;
+
+    std::vector<std::unique_ptr<Bank>> rom_banks;
+    std::array<DecodedOp, 0x2000>      wram{};
+    std::array<DecodedOp, 0x80>        hram{};
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "cpu.h"
+
+// Opcode handlers, generated from the SM83 encoding:
+//
+//   x = op[7:6]   y = op[5:3]   z = op[2:0]   p = y[2:1]   q = y[0]
+//
+// Each opcode gets its own instantiation with every field known at compile
+// time, so an opcode like ADD A, [HL] compiles down to the same code as the
+// hand-written handler it replaces.
+
+template <u8 Op>
+void Cpu::op() {
+    constexpr u8 x = Op >> 6;
+    constexpr u8 y = (Op >> 3) & 0x07;
+    constexpr u8 z = Op & 0x07;
+    constexpr u8 p = y >> 1;
+    constexpr u8 q = y & 0x01;
+
+    // =============================================================
+    //  x = 0
+    // =============================================================
+    if constexpr (x == 0 && z == 0) {
+        if constexpr (y == 0) {
+            // NOP
+        } else if constexpr (y == 1) {
+            LD_a16_SP();
+        } else if constexpr (y == 2) {
+            STOP();
+        } else if constexpr (y == 3) {
+            i8 offset = fetch_u8();
+            reg.PC += offset;
+        } else {
+            JR_COND(cond<y - 4>());
+        }
+    } else if constexpr (x == 0 && z == 1) {
+        if constexpr (q == 0) {
+            r16<p>() = fetch_u16();
+        } else {
+            ADD_HL_R16(r16<p>());
+        }
+    } else if constexpr (x == 0 && z == 2) {
+        // LD [BC], A / LD [DE], A / LD [HL+], A / LD [HL-], A and the loads back
+        u16 addr;
+        if constexpr (p == 0) addr = reg.BC;
+        if constexpr (p == 1) addr = reg.DE;
+        if constexpr (p == 2) addr = reg.HL++;
+        if constexpr (p == 3) addr = reg.HL--;
+
+        if constexpr (q == 0) {
+            mmu.write_u8(addr, reg.A);
+        } else {
+            reg.A = mmu.read_u8(addr);
+        }
+    } else if constexpr (x == 0 && z == 3) {
+        if constexpr (q == 0) {
+            INC_R16(r16<p>());
+        } else {
+            DEC_R16(r16<p>());
+        }
+    } else if constexpr (x == 0 && (z == 4 || z == 5)) {
+        u8 val = load_r8<y>();
+        if constexpr (z == 4) {
+            INC_R(val);
+        } else {
+            DEC_R(val);
+        }
+        store_r8<y>(val);
+    } else if constexpr (x == 0 && z == 6) {
+        store_r8<y>(fetch_u8());
+    } else if constexpr (x == 0 && z == 7) {
+        if constexpr (y == 0) RLCA();
+        if constexpr (y == 1) RRCA();
+        if constexpr (y == 2) RLA();
+        if constexpr (y == 3) RRA();
+        if constexpr (y == 4) DAA();
+        if constexpr (y == 5) CPL();
+        if constexpr (y == 6) SCF();
+        if constexpr (y == 7) CCF();
+    }
+
+    // =============================================================
+    //  x = 1, 2: LD r, r' and ALU A, r
+    // =============================================================
+    else if constexpr (Op == 0x76) {
+        HALT();
+    } else if constexpr (x == 1) {
+        store_r8<y>(load_r8<z>());
+    } else if constexpr (x == 2) {
+        alu<y>(load_r8<z>());
+    }
+
+    // =============================================================
+    //  x = 3
+    // =============================================================
+    else if constexpr (z == 0) {
+        if constexpr (y < 4) {
+            RET_COND(cond<y>());
+        } else if constexpr (y == 4) {
+            mmu.write_io(fetch_u8(), reg.A);
+        } else if constexpr (y == 5) {
+            ADD_SP_e8();
+        } else if constexpr (y == 6) {
+            reg.A = mmu.read_io(fetch_u8());
+        } else {
+            LD_HL_SP_e8();
+        }
+    } else if constexpr (z == 1) {
+        if constexpr (q == 0 && p == 3) {
+            POP_AF();
+        } else if constexpr (q == 0) {
+            r16<p>() = pop();
+        } else if constexpr (p == 0) {
+            reg.PC = pop();
+        } else if constexpr (p == 1) {
+            RETI();
+        } else if constexpr (p == 2) {
+            reg.PC = reg.HL;
+        } else {
+            reg.SP = reg.HL;
+        }
+    } else if constexpr (z == 2) {
+        if constexpr (y < 4) {
+            JP_COND(cond<y>());
+        } else if constexpr (y == 4) {
+            mmu.write_io(reg.C, reg.A);
+        } else if constexpr (y == 5) {
+            mmu.write_u8(fetch_u16(), reg.A);
+        } else if constexpr (y == 6) {
+            reg.A = mmu.read_io(reg.C);
+        } else {
+            reg.A = mmu.read_u8(fetch_u16());
+        }
+    } else if constexpr (Op == 0xC3) {
+        reg.PC = fetch_u16();
+    } else if constexpr (Op == 0xCB) {
+        PREFIX();
+    } else if constexpr (Op == 0xF3) {
+        DI();
+    } else if constexpr (Op == 0xFB) {
+        EI();
+    } else if constexpr (z == 4 && y < 4) {
+        CALL_COND(cond<y>());
+    } else if constexpr (z == 5 && q == 0) {
+        if constexpr (p == 3) {
+            push((reg.A << 8) | reg.flags());
+        } else {
+            push(r16<p>());
+        }
+    } else if constexpr (Op == 0xCD) {
+        u16 addr = fetch_u16();
+        push(reg.PC);
+        reg.PC = addr;
+    } else if constexpr (z == 6) {
+        alu<y>(fetch_u8());
+    } else if constexpr (z == 7) {
+        RST(y * 8);
+    } else {
+        UNIMPLEMENTED();
+    }
+}
+
+template <u8 Op>
+void Cpu::cb() {
+    constexpr u8 x = Op >> 6;
+    constexpr u8 y = (Op >> 3) & 0x07;
+    constexpr u8 z = Op & 0x07;
+
+    if constexpr (x == 1) {
+        BIT_R(y, load_r8<z>());
+    } else {
+        u8 val = load_r8<z>();
+        if constexpr (x == 0) rot<y>(val);
+        if constexpr (x == 2) RES_R(y, val);
+        if constexpr (x == 3) SET_R(y, val);
+        store_r8<z>(val);
+    }
+}
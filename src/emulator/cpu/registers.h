@@ -1,18 +1,25 @@
 #pragma once
 
+// The ALU op that last set the flags. Instead of writing Z/N/H/C on every
+// instruction, the ALU helpers record the op with its operands and result,
+// and the flags are only worked out when something reads them.
+enum class FlagOp : u8 {
+    None,   // F holds the flags
+    Add,    // ADD/ADC: H from operands, C from bit 8 of the result
+    Sub,    // SUB/SBC/CP: same, result wrapped to 16 bits so bit 8 is the borrow
+    And,    // H set, C clear
+    Or,     // OR/XOR: H and C clear
+    Inc,    // H from the result, C carried over in flag_b
+    Dec,    // H from the result, C carried over in flag_b
+    Shift,  // Rotates, shifts and SWAP: H clear, C in flag_b
+};
+
 struct Registers {
+    // F is only up to date while flag_op is FlagOp::None, use flags() to
+    // read it and set_flags()/load_flags() to write it.
     union {
         struct {
-            union {
-                struct {
-                    u8 unused : 4;
-                    u8 c : 1;
-                    u8 h : 1;
-                    u8 n : 1;
-                    u8 z : 1;
-                };
-                u8 F;
-            };
+            u8 F;
             u8 A;
         };
         u16 AF;
@@ -44,4 +51,82 @@ struct Registers {
 
     u16 SP;
     u16 PC;
-};
\ No newline at end of file
+
+    FlagOp flag_op = FlagOp::None;
+    u8     flag_a;
+    u8     flag_b;
+    u16    flag_res;
+
+    inline void lazy(FlagOp op, u8 a, u8 b, u16 res) {
+        flag_op  = op;
+        flag_a   = a;
+        flag_b   = b;
+        flag_res = res;
+    }
+
+    inline bool z() const {
+        if (flag_op == FlagOp::None) return (F & 0x80) != 0;
+        return (flag_res & 0xFF) == 0;
+    }
+
+    inline bool n() const {
+        switch (flag_op) {
+            case FlagOp::None:
+                return (F & 0x40) != 0;
+            case FlagOp::Sub:
+            case FlagOp::Dec:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    inline bool h() const {
+        switch (flag_op) {
+            case FlagOp::None:
+                return (F & 0x20) != 0;
+            case FlagOp::Add:
+            case FlagOp::Sub:
+                return ((flag_a ^ flag_b ^ flag_res) & 0x10) != 0;
+            case FlagOp::And:
+                return true;
+            case FlagOp::Inc:
+                return (flag_res & 0x0F) == 0x00;
+            case FlagOp::Dec:
+                return (flag_res & 0x0F) == 0x0F;
+            default:
+                return false;
+        }
+    }
+
+    inline bool c() const {
+        switch (flag_op) {
+            case FlagOp::None:
+                return (F & 0x10) != 0;
+            case FlagOp::Add:
+            case FlagOp::Sub:
+                return (flag_res & 0x100) != 0;
+            case FlagOp::Inc:
+            case FlagOp::Dec:
+            case FlagOp::Shift:
+                return flag_b != 0;
+            default:
+                return false;
+        }
+    }
+
+    inline u8 flags() const {
+        if (flag_op == FlagOp::None) return F;
+        return (z() << 7) | (n() << 6) | (h() << 5) | (c() << 4);
+    }
+
+    inline void set_flags(bool z, bool n, bool h, bool c) {
+        F       = (z << 7) | (n << 6) | (h << 5) | (c << 4);
+        flag_op = FlagOp::None;
+    }
+
+    inline void load_flags(u8 f) {
+        F       = f;
+        flag_op = FlagOp::None;
+    }
+};
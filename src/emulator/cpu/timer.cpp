@@ -1,12 +1,14 @@
 #include "timer.h"
 
+#include <algorithm>
 #include <tracy/Tracy.hpp>
 
 #include "../emulator.h"
 
-Timer::Timer(Mmu& m) : mmu(m) {
+Timer::Timer(Mmu& m, Scheduler& s) : mmu(m), scheduler(s) {
     counter      = 0;
     tima_counter = 0;
+    last_sync    = scheduler.now;
 }
 
 void Timer::save_state(TimerState& state) const {
@@ -17,32 +19,75 @@ void Timer::save_state(TimerState& state) const {
 void Timer::load_state(const TimerState& state) {
     counter      = state.counter;
     tima_counter = state.tima_counter;
+    last_sync    = scheduler.now;
+
+    schedule_overflow();
+}
+
+void Timer::sync() {
+    tick(scheduler.now - last_sync);
+    last_sync = scheduler.now;
+
+    schedule_overflow();
+}
+
+void Timer::schedule_overflow() {
+    if ((mmu.tac() & 0x04) == 0) {
+        scheduler.cancel(Event::Timer);
+        return;
+    }
+
+    u64 increments = 0x100 - mmu.tima();
+    u64 cycles     = increments * get_clock_threshold(mmu.tac()) - tima_counter;
+    scheduler.schedule(Event::Timer, last_sync + cycles);
 }
 
-void Timer::tick(u8 cycles) {
+// Same result as ticking every instruction, as long as TAC and TMA didn't
+// change in between. Writes to those sync first, so they can't have.
+void Timer::tick(u64 cycles) {
     ZoneScoped;
 
-    counter += cycles;
+    counter   = counter + cycles;
     mmu.div() = counter >> 8;
 
-    if ((mmu.tac() & 0x04) != 0) {
-        tima_counter += cycles;
+    if ((mmu.tac() & 0x04) == 0) {
+        return;
+    }
+
+    int threshold  = get_clock_threshold(mmu.tac());
+    u64 total      = tima_counter + cycles;
+    u64 increments = total / threshold;
+    tima_counter   = total % threshold;
 
-        int threshold = get_clock_threshold(mmu.tac());
+    u64 to_overflow = 0x100 - mmu.tima();
+    if (increments < to_overflow) {
+        mmu.tima() += increments;
+        return;
+    }
 
-        while (tima_counter >= threshold) {
-            tima_counter -= threshold;
-            mmu.tima()++;
+    // Reloaded from TMA on the first overflow, then wraps every 0x100 - TMA
+    increments -= to_overflow;
+    mmu.tima() = mmu.tma() + increments % (0x100 - mmu.tma());
+    mmu.request_interrupt(InterruptType::Timer);
+}
 
-            if (mmu.tima() == 0x00) {
-                mmu.tima() = mmu.tma();
-                mmu.request_interrupt(InterruptType::Timer);
-            }
-        }
+u64 Timer::next_change(u64 cycle) {
+    // Both counters are periodic in a power of two, so wrapping arithmetic
+    // works for a `cycle` before last_sync too.
+    u64 elapsed = cycle - last_sync;
+    u64 next    = cycle + 0x100 - ((counter + elapsed) & 0xFF);
+
+    if (mmu.tac() & 0x04) {
+        u64 threshold = get_clock_threshold(mmu.tac());
+        next          = std::min(next, cycle + threshold - ((tima_counter + elapsed) & (threshold - 1)));
     }
+
+    return next;
 }
 
 void Timer::reset_div_counter() {
+    sync();
+
     counter   = 0;
     mmu.div() = 0;
 }
@@ -1,25 +1,43 @@
 #pragma once
 
 #include "../mmu/mmu.h"
+#include "../scheduler.h"
 
 struct TimerState;
 
+// DIV and TIMA are only worked out when something looks at them: a read or
+// write of FF04-FF07, or the cycle TIMA is due to overflow and raise its
+// interrupt. In between the timer costs nothing.
 class Timer {
    public:
-    Mmu& mmu;
+    Mmu&       mmu;
+    Scheduler& scheduler;
 
-    Timer(Mmu& m);
+    Timer(Mmu& m, Scheduler& s);
 
-    void tick(u8 cycles);
+    // Catches DIV and TIMA up to scheduler.now and schedules the next overflow.
+    void sync();
+
+    // Reschedules the overflow after a TIMA, TMA or TAC write.
+    void schedule_overflow();
 
     void reset_div_counter();
 
+    // First cycle after `cycle` at which a read of DIV or TIMA would return
+    // something else, provided nothing writes the timer registers meanwhile.
+    u64 next_change(u64 cycle);
+
+    u64 synced_at() const { return last_sync; }
+
     void save_state(TimerState& state) const;
     void load_state(const TimerState& state);
 
    private:
     u16 counter;
     int tima_counter;
+    u64 last_sync;
+
+    void tick(u64 cycles);
 
     int get_clock_threshold(u8 tac);
-};
\ No newline at end of file
+};
@@ -1,5 +1,6 @@
 #include "emulator.h"
 
+#include <algorithm>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -7,32 +8,110 @@
 #include <sstream>
 #include <tracy/Tracy.hpp>
 
-Emulator::Emulator(Pak& p) : pak(p), mmu(pak), cpu(mmu), ppu(mmu), timer(mmu), joy(mmu) {
+Emulator::Emulator(Pak& p, Renderer renderer)
+    : pak(p), mmu(pak), cpu(mmu), ppu(mmu, scheduler, renderer), timer(mmu, scheduler), joy(mmu) {
+    mmu.connect_scheduler(&scheduler);
     mmu.set_timer(&timer);
     mmu.connect_ppu(&ppu);
     mmu.connect_joypad(&joy);
+    mmu.connect_decode_cache(&cpu.decode_cache);
+    mmu.connect_tile_cache(&ppu.tile_cache);
+    mmu.connect_render_worker(ppu.worker.get());
+    mmu.connect_sprite_index(&ppu.sprite_index);
 }
 
 void Emulator::run_frame() {
     ZoneScoped;
 
-    int cycles_this_frame = 0;
+    scheduler.schedule(Event::FrameEnd, scheduler.now + Ppu::CYCLES_PER_FRAME);
 
-    while (cycles_this_frame < Ppu::CYCLES_PER_FRAME) {
-        u8 cycles_ran;
+    // Start of the last instruction, the PPU has to see OAM as it was there.
+    u64 last_step = scheduler.now;
 
-        if (mmu.dma_active) {
-            cycles_ran = 4;
-        } else {
-            cycles_ran = cpu.step();
+    while (true) {
+        while (scheduler.now < scheduler.next_event()) {
+            int cycles_ran;
+
+            if (cpu.is_idle()) {
+                // Halted, nothing can change before the next event. Skip
+                // ahead in 4 cycle slices.
+                cycles_ran = (scheduler.next_event() - scheduler.now + 3) & ~3;
+                last_step  = scheduler.now + cycles_ran - 4;
+            } else {
+                u16 pc     = cpu.reg.PC;
+                last_step  = scheduler.now;
+                cycles_ran = cpu.step();
+
+                if (cpu.reg.PC < pc && pc - cpu.reg.PC <= IdleLoop::MAX_LENGTH) {
+                    cycles_ran += skip_idle_loop(scheduler.now + cycles_ran);
+                }
+            }
+
+            scheduler.now += cycles_ran;
+        }
+
+        // Whatever the CPU was polling may change now
+        idle_loop.valid = false;
+
+        // Same order the components used to be ticked in
+        if (scheduler.is_due(Event::Timer)) {
+            timer.sync();
+        }
+
+        if (scheduler.is_due(Event::Ppu)) {
+            mmu.sync_dma(last_step);
+            ppu.sync();
+        }
+
+        if (scheduler.is_due(Event::Dma)) {
+            mmu.sync_dma(scheduler.now);
         }
 
-        timer.tick(cycles_ran);
-        ppu.tick(cycles_ran);
-        mmu.tick_dma(cycles_ran);
+        if (scheduler.is_due(Event::FrameEnd)) {
+            break;
+        }
+    }
+}
 
-        cycles_this_frame += cycles_ran;
+// Called when the CPU has just jumped back to the top of what may be a
+// busy-wait loop, at `cycle`. If it is in exactly the state it was in when it
+// last got here, with no writes in between, every iteration from now on is
+// the same one over again until something it reads changes. Without a write
+// that can only be an event or, if the loop reads the timer, DIV or TIMA
+// ticking over. Skips the whole iterations that fit before then and returns
+// the cycles they would have taken.
+u64 Emulator::skip_idle_loop(u64 cycle) {
+    CpuState state;
+    cpu.save_state(state);
+
+    bool repeated = idle_loop.valid && idle_loop.write_count == mmu.write_count &&
+                    std::memcmp(&idle_loop.cpu, &state, sizeof(CpuState)) == 0;
+
+    u64 skipped = 0;
+    if (repeated) {
+        u64 period = cycle - idle_loop.cycle;
+        u64 limit  = scheduler.next_event();
+
+        if (timer.synced_at() != idle_loop.timer_sync) {
+            limit = std::min(limit, timer.next_change(idle_loop.cycle));
+        }
+
+        if (limit > cycle) {
+            skipped = (limit - cycle) / period * period;
+        }
+
+        if (skipped > 0) {
+            idle_loops_skipped++;
+        }
     }
+
+    idle_loop.valid       = true;
+    idle_loop.cycle       = cycle + skipped;
+    idle_loop.write_count = mmu.write_count;
+    idle_loop.timer_sync  = timer.synced_at();
+    idle_loop.cpu         = state;
+
+    return skipped;
 }
 
 void Emulator::save_state(const std::string& rom_path) {
@@ -45,6 +124,11 @@ void Emulator::save_state(const std::string& rom_path) {
         return;
     }
 
+    // Bring everything up to the current cycle so the state is complete
+    timer.sync();
+    mmu.sync_dma(scheduler.now);
+    ppu.sync();
+
     SaveHeader header;
     out.write(reinterpret_cast<char*>(&header), sizeof(SaveHeader));
 
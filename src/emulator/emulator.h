@@ -17,13 +17,14 @@
 #include "pak/pak.h"
 #include "ppu/ppu.h"
 #include "ppu/screen.h"
+#include "scheduler.h"
 
 // IMPORTANT!
 // If a future change alters any of the state structs below, remember
 // to increment version number.
 struct SaveHeader {
     char magic[4] = {'G', 'B', 'S', 'T'};
-    u32  version  = 1;
+    u32  version  = 3;
 };
 
 #pragma pack(push, 1)
@@ -58,26 +59,45 @@ struct MmuState {
 };
 
 struct MbcState {
-    bool is_eram_enabled;
-    int  rom_bank;
-    int  ram_bank;
+    bool               is_eram_enabled;
+    std::array<u8, 32> registers;  // Whatever the mapper needs, see its save_registers
 };
 #pragma pack(pop)
 
+// The CPU's state the last time it jumped back a short distance, see
+// Emulator::skip_idle_loop.
+struct IdleLoop {
+    static constexpr u16 MAX_LENGTH = 16;
+
+    bool     valid = false;
+    u64      cycle;
+    u64      write_count;
+    u64      timer_sync;
+    CpuState cpu;
+};
+
 class Emulator {
    public:
-    Pak&   pak;
-    Mmu    mmu;
-    Cpu    cpu;
-    Ppu    ppu;
-    Timer  timer;
-    Joypad joy;
-
-    Emulator(Pak& p);
+    Pak&      pak;
+    Scheduler scheduler;
+    Mmu       mmu;
+    Cpu       cpu;
+    Ppu       ppu;
+    Timer     timer;
+    Joypad    joy;
+
+    u64 idle_loops_skipped = 0;
+
+    Emulator(Pak& p, Renderer renderer = Renderer::Fast);
     ~Emulator() = default;
 
     void run_frame();
 
     void save_state(const std::string& rom_path);
     void load_state(const std::string& rom_path);
+
+   private:
+    IdleLoop idle_loop;
+
+    u64 skip_idle_loop(u64 cycle);
 };
\ No newline at end of file
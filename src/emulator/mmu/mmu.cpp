@@ -1,17 +1,25 @@
 #include "mmu.h"
 
+#include <algorithm>
+#include <cstring>
 #include <tracy/Tracy.hpp>
 
+#include "../cpu/decode_cache.h"
 #include "../cpu/timer.h"
 #include "../emulator.h"
 #include "../joypad.h"
+#include "../pak/mbc/mappers.h"
 #include "../pak/pak.h"
 #include "../ppu/ppu.h"
+#include "../ppu/render_worker.h"
+#include "../ppu/sprite_index.h"
+#include "../ppu/tile_cache.h"
+#include "../scheduler.h"
 
 Mmu::Mmu(Pak& p) : pak(p) {
     memory_map.fill(nullptr);
 
-    u8* rom_ptr = pak.data.data();
+    u8* rom_ptr = pak.image->data();
 
     // ROM | 0x0000 - 0x7FFF
     for (int i = 0; i <= 0x7; i++) {
@@ -39,6 +47,7 @@ Mmu::Mmu(Pak& p) : pak(p) {
     IF = 0;
 
     init_io_registers();
+    update_all_pages();
 };
 
 void Mmu::save_state(MmuState& state) const {
@@ -65,20 +74,88 @@ void Mmu::load_state(const MmuState& state) {
     dma_active      = state.dma_active;
     dma_source_addr = state.dma_source_addr;
     dma_progress    = state.dma_progress;
+
+    resolve_dma_source();
+    update_all_pages();
+
+    if (tile_cache_ptr) tile_cache_ptr->invalidate_all();
+    if (sprite_index_ptr) sprite_index_ptr->rebuild();
+
+    // One byte per 4 cycles, so the transfer started dma_progress * 4 cycles ago
+    if (dma_active) {
+        dma_start = scheduler_ptr->now - dma_progress * 4;
+        scheduler_ptr->schedule(Event::Dma, dma_start + 160 * 4);
+    } else {
+        scheduler_ptr->cancel(Event::Dma);
+    }
+}
+
+void Mmu::map_page(u8 page_i, u8* ptr) {
+    // MBCs remap every page a bank register affects, most stay where they are
+    if (memory_map[page_i] == ptr) return;
+
+    memory_map[page_i] = ptr;
+
+    for (int i = 0; i < 16; i++) {
+        update_page((page_i << 4) | i);
+    }
 }
 
 void Mmu::map_rom_page(u8 page_i, u16 bank_n) {
     int rom_offset  = bank_n * 0x4000;
     int page_offset = (page_i - 4) * 0x1000;
 
-    memory_map[page_i] = pak.data.data() + rom_offset + page_offset;
+    map_page(page_i, pak.image->data() + rom_offset + page_offset);
 }
 
-void Mmu::map_ram_page(u8 page_i, u8* ptr) { memory_map[page_i] = ptr; }
+void Mmu::map_ram_page(u8 page_i, u8* ptr) { map_page(page_i, ptr); }
 
-u8 Mmu::read_u8(u16 addr) {
-    ZoneScoped;
+void Mmu::update_vram_pages() {
+    for (int page = 0x80; page < 0xA0; page++) {
+        update_page(page);
+    }
+}
+
+void Mmu::mark_code(u16 addr) {
+    if (addr < 0xC000 || addr >= 0xE000) return;
+
+    u8 wram_page = (addr >> 8) & 0x1F;
+    if (code_pages & (1u << wram_page)) return;
 
+    code_pages |= 1u << wram_page;
+    update_page(0xC0 | wram_page);
+    if ((0xE0 | wram_page) < 0xFE) update_page(0xE0 | wram_page);  // Echo
+}
+
+// Works out whether read_slow/write_slow would end up doing a plain access of
+// the same byte for every address in `page`, and if so points at it.
+void Mmu::update_page(u8 page) {
+    u8* direct = nullptr;
+    if (page < 0xF0) {
+        if (memory_map[page >> 4]) direct = memory_map[page >> 4] + ((page & 0x0F) << 8);
+    } else if (page < 0xFE) {
+        direct = ram.wram.data() + ((page << 8) & 0x1FFF);  // Echo RAM
+    }
+
+    bool is_vram      = page >= 0x80 && page < 0xA0;
+    bool blocked      = dma_active || (is_vram && static_cast<Mode>(stat() & 0x3) == Mode::Drawing);
+    bool is_code      = page >= 0xC0 && (code_pages & (1u << (page & 0x1F)));
+    read_pages[page]  = blocked ? nullptr : direct;
+    write_pages[page] = (blocked || page < 0x80 || is_code || is_vram) ? nullptr : direct;
+}
+
+void Mmu::update_all_pages() {
+    for (int page = 0; page < 0x100; page++) {
+        update_page(page);
+    }
+}
+
+void Mmu::set_dma_active(bool active) {
+    dma_active = active;
+    update_all_pages();
+}
+
+u8 Mmu::read_slow(u16 addr) {
     if (dma_active && addr < 0xFF80) {
         return 0xFF;
     }
@@ -92,7 +169,10 @@ u8 Mmu::read_u8(u16 addr) {
         }
 
         u8* page = memory_map[addr >> 12];
-        if (page == nullptr) return 0xFF;
+        if (page == nullptr) {
+            // Only ERAM is ever unmapped, the mapper decides what's there
+            return pak.mbc ? visit_mbc(pak, [addr](auto& mbc) { return mbc.read_ram(addr); }) : 0xFF;
+        }
         return page[addr & 0x0FFF];
     } else if (addr < 0xFE00) {  // ---- Remaining Echo RAM, Mirror of C000-DDFF | 0xE000 - FDFF
         return ram.read_echo(addr);
@@ -104,33 +184,19 @@ u8 Mmu::read_u8(u16 addr) {
         return ram.read_oam(addr);
     } else if (addr < 0xFF00) {  // ---- Not Usable | 0xFEA0 - 0xFEFF
         return 0xFF;
-
-    } else if (addr < 0xFF80) {  // ---- IO Registers | 0xFF00 - 0xFF7F
-        if (addr == 0xFF00) {
-            if (joy_ptr) {
-                return joy_ptr->get_joyp_register();
-            }
-        } else if (addr == 0xFF0F) {
-            return IF;
-        }
-        return ram.read_io(addr);
-    } else if (addr < 0xFFFF) {  // ---- HRAM | 0xFF80 - 0xFFFE
-        return ram.read_hram(addr);
-    } else {
-        return IE;
+    } else {  // ---------------------- IO Registers, HRAM and IE | 0xFF00 - 0xFFFF
+        return (this->*io_read_handlers[addr & 0xFF])(addr & 0xFF);
     }
 }
 
-void Mmu::write_u8(u16 addr, u8 val) {
-    ZoneScoped;
-
+void Mmu::write_slow(u16 addr, u8 val) {
     if (dma_active && addr < 0xFF80) {
         return;
     }
 
     if (addr < 0x8000) {  // ----------- ROM
         if (pak.mbc) {
-            pak.mbc->write_rom(addr, val);
+            visit_mbc(pak, [addr, val](auto& mbc) { mbc.write_rom(addr, val); });
         }
         return;
     }
@@ -145,99 +211,210 @@ void Mmu::write_u8(u16 addr, u8 val) {
         u8* page = memory_map[addr >> 12];
         if (page != nullptr) {
             page[addr & 0x0FFF] = val;
+        } else if (pak.mbc) {
+            visit_mbc(pak, [addr, val](auto& mbc) { mbc.write_ram(addr, val); });
+        }
+
+        if (addr >= 0xC000 && decode_cache_ptr) {
+            decode_cache_ptr->invalidate_wram(addr);
+        } else if (addr < 0xA000 && addr >= 0x8000) {
+            if (addr < 0x9800 && tile_cache_ptr) tile_cache_ptr->invalidate(addr);
+            if (render_worker_ptr) render_worker_ptr->write_vram(addr, val);
         }
         return;
     }
 
     if (addr < 0xFE00) {  // ----------- Remaining Echo RAM, Mirror of C000-DDFF | 0xE000 - FDFF
         ram.write_echo(addr, val);
+        if (decode_cache_ptr) decode_cache_ptr->invalidate_wram(addr);
     } else if (addr < 0xFEA0) {  // ---- OAM | 0xFE00 - FE9F
         Mode mode = ppu_ptr->get_mode();
         if (mode == Mode::OamScan || mode == Mode::Drawing) {
             return;
         }
         ram.write_oam(addr, val);
+        if (sprite_index_ptr) sprite_index_ptr->update(addr - 0xFE00, addr - 0xFE00 + 1);
     } else if (addr < 0xFF00) {  // ---- Not Usable | 0xFEA0 - 0xFEFF
-    } else if (addr < 0xFF80) {  // ---- IO Registers | 0xFF00 - 0xFF7F
-        // ##############################################
-        // # Special cases, return immediately
-        if (addr == 0xFF00) {  // JOYP register
-            if (joy_ptr) joy_ptr->set_joyp_register(val);
-            return;
-        } else if (addr == 0xFF04) {
-            if (timer_ptr) timer_ptr->reset_div_counter();
-            return;
-        } else if (addr == 0xFF41) {  // Protecting STAT register's lower 3 bits.
-            u8 current_val = stat();
-            stat()         = (current_val & 0x07) | (val & 0xF8);
-            return;
-        } else if (addr == 0xFF44) {  // LY register is reset on write
-            ly() = 0;
-            return;
-        }
-
-        // ##############################################
-        // # Perform write for other registers
-        ram.write_io(addr, val);
-
-        // ##############################################
-        // # Handling side-effects of a write
-        if (addr == 0xFF0F) {
-            IF = val;
-        } else if (addr == 0xFF46) {  // DMA Transfer
-            dma_active      = true;
-            dma_source_addr = val << 8;
-            dma_progress    = 0;
-        } else if (addr == 0xFF47 || addr == 0xFF48 || addr == 0xFF49) {
-            if (ppu_ptr) ppu_ptr->update_palettes();
-        }
-    } else if (addr < 0xFFFF) {  // ---- HRAM | 0xFF80 - 0xFFFE
-        ram.write_hram(addr, val);
-    } else {
-        IE = val;
+    } else {  // ---------------------- IO Registers, HRAM and IE | 0xFF00 - 0xFFFF
+        (this->*io_write_handlers[addr & 0xFF])(addr & 0xFF, val);
     }
 }
 
-u8 Mmu::ppu_read_u8(u16 addr) {
-    ZoneScoped;
+// =============================================================
+//  IO Registers
+// =============================================================
+u8 Mmu::read_register(u8 reg) { return ram.io[reg]; }
 
-    if (addr >= 0x8000 && addr <= 0x9FFF) {
-        u8* page = memory_map[addr >> 12];
-        if (page == nullptr) return 0xFF;
-        return page[addr & 0x0FFF];
-    } else if (addr >= 0xFE00 && addr <= 0xFE9F) {
-        return ram.read_oam(addr);
-    }
+u8 Mmu::read_joyp(u8 reg) {
+    if (joy_ptr) return joy_ptr->get_joyp_register();
+    return ram.io[reg];
+}
 
-    return 0xFF;
+u8 Mmu::read_timer(u8 reg) {
+    if (timer_ptr) timer_ptr->sync();
+    return ram.io[reg];
 }
 
-void Mmu::tick_dma(u8 cycles) {
-    ZoneScoped;
+u8 Mmu::read_if(u8 reg) { return IF; }
 
-    if (!dma_active) return;
+u8 Mmu::read_hram(u8 reg) { return ram.hram[reg - 0x80]; }
 
-    int bytes_to_copy = cycles / 4;
-    for (int i = 0; i < bytes_to_copy; i++) {
-        u16 src_addr = dma_source_addr + dma_progress;
-        u8  data     = 0xFF;  // default
+u8 Mmu::read_ie(u8 reg) { return IE; }
 
-        if (src_addr < 0xF000) {  // ROM, VRAM, ERAM, WRAM
-            u8* page = memory_map[src_addr >> 12];
-            if (page != nullptr) {
-                data = page[src_addr & 0x0FFF];
-            }
-        } else if (src_addr < 0xFE00) {  // Echo RAM
-            data = ram.read_echo(src_addr);
-        }
+void Mmu::write_register(u8 reg, u8 val) { ram.io[reg] = val; }
+
+void Mmu::write_joyp(u8 reg, u8 val) {
+    if (joy_ptr) joy_ptr->set_joyp_register(val);
+}
 
-        ram.write_oam(0xFE00 + dma_progress, data);
-        dma_progress++;
+void Mmu::write_div(u8 reg, u8 val) {
+    if (timer_ptr) timer_ptr->reset_div_counter();
+}
+
+void Mmu::write_timer(u8 reg, u8 val) {
+    if (timer_ptr) timer_ptr->sync();
+    ram.io[reg] = val;
+    if (timer_ptr) timer_ptr->schedule_overflow();
+}
 
-        if (dma_progress >= 160) {
-            dma_active = false;
-            break;
+void Mmu::write_if(u8 reg, u8 val) {
+    ram.io[reg] = val;
+    IF          = val;
+}
+
+// LCDC, SCY, SCX and LYC
+void Mmu::write_lcd(u8 reg, u8 val) {
+    if (ppu_ptr) ppu_ptr->sync_for_write();
+    ram.io[reg] = val;
+}
+
+void Mmu::write_lcdc(u8 reg, u8 val) {
+    write_lcd(reg, val);
+    if (ppu_ptr) ppu_ptr->update_lcdc();
+}
+
+// Protecting STAT register's lower 3 bits.
+void Mmu::write_stat(u8 reg, u8 val) {
+    if (ppu_ptr) ppu_ptr->sync_for_write();
+    stat() = (stat() & 0x07) | (val & 0xF8);
+}
+
+// LY register is reset on write
+void Mmu::write_ly(u8 reg, u8 val) {
+    if (ppu_ptr) ppu_ptr->sync_for_write();
+    ly() = 0;
+}
+
+// Can't restart a running transfer, write_slow() drops this while DMA is on
+void Mmu::write_dma(u8 reg, u8 val) {
+    ram.io[reg]     = val;
+    dma_source_addr = val << 8;
+    dma_progress    = 0;
+    dma_start       = scheduler_ptr->now;
+    scheduler_ptr->schedule(Event::Dma, dma_start + 160 * 4);
+    resolve_dma_source();
+    set_dma_active(true);
+}
+
+void Mmu::write_palette(u8 reg, u8 val) {
+    if (ppu_ptr) ppu_ptr->sync_for_render();
+    ram.io[reg] = val;
+    if (ppu_ptr) ppu_ptr->update_palette(reg);
+}
+
+// WY and WX
+void Mmu::write_window(u8 reg, u8 val) {
+    if (ppu_ptr) ppu_ptr->sync_for_render();
+    ram.io[reg] = val;
+}
+
+void Mmu::write_hram(u8 reg, u8 val) {
+    ram.hram[reg - 0x80] = val;
+    if (decode_cache_ptr) decode_cache_ptr->invalidate_hram(0xFF00 | reg);
+}
+
+void Mmu::write_ie(u8 reg, u8 val) { IE = val; }
+
+struct IoTable {
+    static constexpr std::array<Mmu::IoReadHandler, 256> reads() {
+        std::array<Mmu::IoReadHandler, 256> table{};
+        for (int reg = 0x00; reg < 0x80; reg++) table[reg] = &Mmu::read_register;
+        for (int reg = 0x80; reg < 0xFF; reg++) table[reg] = &Mmu::read_hram;
+
+        table[0x00] = &Mmu::read_joyp;
+        table[0x04] = &Mmu::read_timer;
+        table[0x05] = &Mmu::read_timer;
+        table[0x06] = &Mmu::read_timer;
+        table[0x07] = &Mmu::read_timer;
+        table[0x0F] = &Mmu::read_if;
+        table[0xFF] = &Mmu::read_ie;
+        return table;
+    }
+
+    static constexpr std::array<Mmu::IoWriteHandler, 256> writes() {
+        std::array<Mmu::IoWriteHandler, 256> table{};
+        for (int reg = 0x00; reg < 0x80; reg++) table[reg] = &Mmu::write_register;
+        for (int reg = 0x80; reg < 0xFF; reg++) table[reg] = &Mmu::write_hram;
+
+        table[0x00] = &Mmu::write_joyp;
+        table[0x04] = &Mmu::write_div;
+        table[0x05] = &Mmu::write_timer;
+        table[0x06] = &Mmu::write_timer;
+        table[0x07] = &Mmu::write_timer;
+        table[0x0F] = &Mmu::write_if;
+        table[0x40] = &Mmu::write_lcdc;
+        table[0x41] = &Mmu::write_stat;
+        table[0x42] = &Mmu::write_lcd;
+        table[0x43] = &Mmu::write_lcd;
+        table[0x44] = &Mmu::write_ly;
+        table[0x45] = &Mmu::write_lcd;
+        table[0x46] = &Mmu::write_dma;
+        table[0x47] = &Mmu::write_palette;
+        table[0x48] = &Mmu::write_palette;
+        table[0x49] = &Mmu::write_palette;
+        table[0x4A] = &Mmu::write_window;
+        table[0x4B] = &Mmu::write_window;
+        table[0xFF] = &Mmu::write_ie;
+        return table;
+    }
+};
+
+constexpr std::array<Mmu::IoReadHandler, 256>  Mmu::io_read_handlers  = IoTable::reads();
+constexpr std::array<Mmu::IoWriteHandler, 256> Mmu::io_write_handlers = IoTable::writes();
+
+void Mmu::sync_dma(u64 cycle) {
+    ZoneScoped;
+
+    if (!dma_active || cycle <= dma_start) return;
+
+    u64 bytes_due = std::min<u64>((cycle - dma_start) / 4, 160);
+    if (dma_progress < bytes_due) {
+        u8* dst = ram.oam.data() + dma_progress;
+        if (dma_source) {
+            std::memcpy(dst, dma_source + dma_progress, bytes_due - dma_progress);
+        } else {
+            std::memset(dst, 0xFF, bytes_due - dma_progress);
         }
+        if (sprite_index_ptr) sprite_index_ptr->update(dma_progress, bytes_due);
+        dma_progress = bytes_due;
+    }
+
+    if (dma_progress >= 160) {
+        set_dma_active(false);
+        scheduler_ptr->cancel(Event::Dma);
+    }
+}
+
+// The CPU can't write anything outside HRAM during the transfer, so the
+// source can't move or change until it's done.
+void Mmu::resolve_dma_source() {
+    if (dma_source_addr < 0xF000) {  // ROM, VRAM, ERAM, WRAM
+        u8* page   = memory_map[dma_source_addr >> 12];
+        dma_source = page ? page + (dma_source_addr & 0x0FFF) : nullptr;
+    } else if (dma_source_addr < 0xFE00) {  // Echo RAM
+        dma_source = ram.wram.data() + (dma_source_addr & 0x1FFF);
+    } else {
+        dma_source = nullptr;
     }
 }
 
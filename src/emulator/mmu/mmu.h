@@ -6,9 +6,14 @@
 
 struct MmuState;
 class Pak;
+class DecodeCache;
+class TileCache;
+class RenderWorker;
+class SpriteIndex;
 class Timer;
 class Ppu;
 class Joypad;
+class Scheduler;
 
 enum class InterruptType : u8 {
     VBlank = 0,
@@ -31,29 +36,83 @@ class Mmu {
     Ppu*   ppu_ptr   = nullptr;
     Joypad* joy_ptr = nullptr;
 
+    DecodeCache*  decode_cache_ptr  = nullptr;
+    TileCache*    tile_cache_ptr    = nullptr;
+    RenderWorker* render_worker_ptr = nullptr;
+    SpriteIndex*  sprite_index_ptr  = nullptr;
+    Scheduler*    scheduler_ptr     = nullptr;
+
+    // Backing memory of each 4K page, nullptr where there is none. What the
+    // page tables below are built from.
     std::array<u8*, 16> memory_map;
 
     bool dma_active = false;
     u16  dma_source_addr;
     u8   dma_progress;
+    u64  dma_start;  // Cycle of the instruction that wrote FF46
+
+    u64 write_count = 0;  // Every CPU write, lets run_frame tell a loop has no side effects
 
+    void map_page(u8 page_i, u8* ptr);
     void map_rom_page(u8 page_i, u16 bank_n);
     void map_ram_page(u8 page_i, u8* ptr);
 
+    // Called by the PPU when it enters or leaves mode 3
+    void update_vram_pages();
+
+    // Code in WRAM is cached by the decode cache, so writes to the page `addr`
+    // is in have to go through write_slow from now on to invalidate it.
+    void mark_code(u16 addr);
+
     void set_timer(Timer* t) { timer_ptr = t; }
     void connect_ppu(Ppu* p) { ppu_ptr = p; }
     void connect_joypad(Joypad* joy) {joy_ptr = joy;}
+    void connect_decode_cache(DecodeCache* c) { decode_cache_ptr = c; }
+    void connect_tile_cache(TileCache* c) { tile_cache_ptr = c; }
+    void connect_render_worker(RenderWorker* w) { render_worker_ptr = w; }
+    void connect_sprite_index(SpriteIndex* s) { sprite_index_ptr = s; }
+    void connect_scheduler(Scheduler* s) { scheduler_ptr = s; }
 
     void save_state(MmuState &state) const;
     void load_state(const MmuState& state);
 
-    void tick_dma(u8 cycles);
+    // Copies the OAM DMA bytes due by `cycle`. The CPU can only reach HRAM
+    // while the transfer runs, so this only has to happen when the PPU looks
+    // at OAM or the transfer ends.
+    void sync_dma(u64 cycle);
 
     void request_interrupt(InterruptType type);
 
-    u8   read_u8(u16 addr);
-    void write_u8(u16 addr, u8 val);
-    u8   ppu_read_u8(u16 addr);
+    inline u8 read_u8(u16 addr) {
+        const u8* page = read_pages[addr >> 8];
+        if (page) return page[addr & 0xFF];
+        return read_slow(addr);
+    }
+
+    inline void write_u8(u16 addr, u8 val) {
+        write_count++;
+
+        u8* page = write_pages[addr >> 8];
+        if (page) {
+            page[addr & 0xFF] = val;
+            return;
+        }
+        write_slow(addr, val);
+    }
+
+    // FF00 + reg, what LDH and LD (C) address. Goes straight to the
+    // register's handler.
+    inline u8 read_io(u8 reg) {
+        if (dma_active && reg < 0x80) return 0xFF;
+        return (this->*io_read_handlers[reg])(reg);
+    }
+
+    inline void write_io(u8 reg, u8 val) {
+        write_count++;
+
+        if (dma_active && reg < 0x80) return;
+        (this->*io_write_handlers[reg])(reg, val);
+    }
 
     u8& p1() { return ram.io[0x00]; }
 
@@ -91,5 +150,59 @@ class Mmu {
     u8& wx() { return ram.io[0x4B]; }
 
    private:
+    // One entry per 256 bytes. Points at the memory behind the page when an
+    // access is a plain load or store, nullptr when it needs read_slow or
+    // write_slow: IO, OAM, ROM writes, VRAM in mode 3, everything during OAM
+    // DMA, WRAM with cached code in it, and all VRAM writes so the tile cache
+    // and the render worker can see them.
+    std::array<u8*, 256> read_pages;
+    std::array<u8*, 256> write_pages;
+
+    u32 code_pages = 0;  // WRAM pages mark_code has seen, one bit each
+
+    void update_page(u8 page);
+    void update_all_pages();
+    const u8* dma_source = nullptr;  // nullptr when the source reads as 0xFF
+
+    void set_dma_active(bool active);
+    void resolve_dma_source();
+
+    u8   read_slow(u16 addr);
+    void write_slow(u16 addr, u8 val);
+
+    // =============================================================
+    //  IO Registers
+    // =============================================================
+    // One handler per address in FF00-FFFF, built in mmu.cpp.
+    using IoReadHandler  = u8 (Mmu::*)(u8 reg);
+    using IoWriteHandler = void (Mmu::*)(u8 reg, u8 val);
+
+    static const std::array<IoReadHandler, 256>  io_read_handlers;
+    static const std::array<IoWriteHandler, 256> io_write_handlers;
+
+    friend struct IoTable;
+
+    u8 read_register(u8 reg);
+    u8 read_joyp(u8 reg);
+    u8 read_timer(u8 reg);
+    u8 read_if(u8 reg);
+    u8 read_hram(u8 reg);
+    u8 read_ie(u8 reg);
+
+    void write_register(u8 reg, u8 val);
+    void write_joyp(u8 reg, u8 val);
+    void write_div(u8 reg, u8 val);
+    void write_timer(u8 reg, u8 val);
+    void write_if(u8 reg, u8 val);
+    void write_lcd(u8 reg, u8 val);
+    void write_lcdc(u8 reg, u8 val);
+    void write_stat(u8 reg, u8 val);
+    void write_ly(u8 reg, u8 val);
+    void write_dma(u8 reg, u8 val);
+    void write_palette(u8 reg, u8 val);
+    void write_window(u8 reg, u8 val);
+    void write_hram(u8 reg, u8 val);
+    void write_ie(u8 reg, u8 val);
+
     void init_io_registers();
 };
\ No newline at end of file
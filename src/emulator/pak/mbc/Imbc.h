@@ -8,7 +8,20 @@ class Imbc {
    public:
     virtual ~Imbc()                            = default;
     virtual void write_rom(u16 addr, u8 val)   = 0;
+    virtual u8   read_ram(u16 addr)            = 0;
+    virtual void write_ram(u16 addr, u8 val)   = 0;
     virtual void set_mmu(Mmu* m)               = 0;
     virtual void save_state(std::ostream& out) = 0;
     virtual void load_state(std::istream& in)  = 0;
-};
\ No newline at end of file
+};
+
+// Which final mapper class an Imbc is, so hot paths can switch on it and
+// call the mapper directly, see visit_mbc() in mappers.h
+enum class MbcKind {
+    Mbc0,
+    Mbc1,
+    Mbc2,
+    Mbc3,
+    Mbc5,
+    HuC1,
+};
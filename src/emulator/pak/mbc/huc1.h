@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../pak.h"
+#include "mbc.h"
+
+// Hudson's MBC1 lookalike. There's no RAM enable, the first register switches
+// 0xA000 - 0xBFFF between RAM and the infrared port instead.
+class HuC1 final : public Base {
+   public:
+    static constexpr MbcKind KIND = MbcKind::HuC1;
+
+    HuC1(Pak& p, int eram_size) : Base(p, eram_size) { is_eram_enabled = true; }
+
+    void set_mmu(Mmu* m) override {
+        Base::set_mmu(m);
+        update_ram_banking();
+    }
+
+    void write_rom(u16 addr, u8 val) override {
+        switch (addr >> 13) {
+            case 0:  // 0x0000 - 0x1FFF
+                is_eram_enabled = (val & 0x0F) != 0x0E;
+                update_ram_banking();
+                break;
+            case 1:  // 0x2000 - 0x3FFF
+                rom_bank_register = val & 0x3F;
+                if (rom_bank_register == 0) rom_bank_register = 1;
+                update_rom_banking();
+                break;
+            case 2:  // 0x4000 - 0x5FFF
+                ram_bank_register = val & 0x03;
+                update_ram_banking();
+                break;
+        }
+    }
+
+    // IR mode. Nothing is ever on the other end, so the receiver never sees
+    // light and the LED (bit 0 of a write) goes nowhere.
+    u8 read_ram(u16 addr) override { return is_eram_enabled ? 0xFF : 0xC0; }
+
+   private:
+    u8 rom_bank_register = 1;
+    u8 ram_bank_register = 0;
+
+    void update_rom_banking() {
+        if (mmu == nullptr) return;
+
+        map_rom_bank(1, rom_bank_register);
+    }
+
+    void update_ram_banking() {
+        if (mmu == nullptr) return;
+
+        if (is_eram_enabled && !ram_banks.empty()) {
+            map_ram_bank(ram_bank_register);
+        } else {
+            map_ram(nullptr);
+        }
+    }
+
+    void save_registers(MbcState& state) const override {
+        state.registers[0] = rom_bank_register;
+        state.registers[1] = ram_bank_register;
+    }
+
+    void load_registers(const MbcState& state) override {
+        rom_bank_register = state.registers[0];
+        ram_bank_register = state.registers[1];
+        update_rom_banking();
+        update_ram_banking();
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "huc1.h"
+#include "mbc0.h"
+#include "mbc1.h"
+#include "mbc2.h"
+#include "mbc3.h"
+#include "mbc5.h"
+
+// Calls fn with the Pak's mapper as its own final class. Every case is a
+// direct call the compiler can inline, so the caller ends up with each
+// mapper's handler in its switch instead of a call through Imbc's vtable.
+template <typename F>
+inline decltype(auto) visit_mbc(Pak& pak, F&& fn) {
+    Imbc& mbc = *pak.mbc;
+
+    switch (pak.mbc_kind) {
+        case MbcKind::Mbc0:
+            return fn(static_cast<Mbc0&>(mbc));
+        case MbcKind::Mbc1:
+            return fn(static_cast<Mbc1&>(mbc));
+        case MbcKind::Mbc2:
+            return fn(static_cast<Mbc2&>(mbc));
+        case MbcKind::Mbc3:
+            return fn(static_cast<Mbc3&>(mbc));
+        case MbcKind::Mbc5:
+            return fn(static_cast<Mbc5&>(mbc));
+        case MbcKind::HuC1:
+        default:
+            return fn(static_cast<HuC1&>(mbc));
+    }
+}
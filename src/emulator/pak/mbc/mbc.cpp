@@ -4,14 +4,27 @@
 
 #include "../pak.h"
 
+Base::Base(Pak& p, int eram_size) : pak(p) {
+    eram.resize(eram_size);
+    is_eram_enabled = false;
+
+    for (size_t offset = 0; offset < pak.image->size(); offset += 0x4000) {
+        rom_banks.push_back(pak.image->data() + offset);
+    }
+
+    // A 2K ERAM has no whole bank, the mappers leave it unmapped
+    for (size_t offset = 0; offset + 0x2000 <= eram.size(); offset += 0x2000) {
+        ram_banks.push_back(eram.data() + offset);
+    }
+}
+
 void Base::save_state(std::ostream& out) {
-    MbcState mbc_state;
+    MbcState mbc_state{};
     mbc_state.is_eram_enabled = is_eram_enabled;
-    mbc_state.rom_bank        = rom_bank;
-    mbc_state.ram_bank        = ram_bank;
+    save_registers(mbc_state);
     out.write(reinterpret_cast<const char*>(&mbc_state), sizeof(MbcState));
 
-    if (is_eram_enabled && !eram.empty()) {
+    if (!eram.empty()) {
         out.write(reinterpret_cast<const char*>(eram.data()), eram.size());
     }
 }
@@ -20,28 +33,10 @@ void Base::load_state(std::istream& in) {
     MbcState mbc_state;
     in.read(reinterpret_cast<char*>(&mbc_state), sizeof(MbcState));
     is_eram_enabled = mbc_state.is_eram_enabled;
-    rom_bank        = mbc_state.rom_bank;
-    ram_bank        = mbc_state.ram_bank;
 
-    if (is_eram_enabled && !eram.empty()) {
+    if (!eram.empty()) {
         in.read(reinterpret_cast<char*>(eram.data()), eram.size());
     }
 
-    // Simplistic reapplication of banking to the MMU to restore correct 
-    // memory map. Will need to keep that in mind if/when implementing
-    // future MBCs.
-    if (mmu) {
-        // ROM Bank: 0x4000-0x7FFF
-        u16 effective_rom_bank = (rom_bank == 0) ? 1 : rom_bank;
-        mmu->map_rom_page(4, effective_rom_bank);
-        mmu->map_rom_page(5, effective_rom_bank);
-        mmu->map_rom_page(6, effective_rom_bank);
-        mmu->map_rom_page(7, effective_rom_bank);
-
-        // RAM Bank: 0xA000-0xBFFF
-        if (is_eram_enabled && !eram.empty() && ram_bank < (eram.size() / 0x2000)) {
-            mmu->map_ram_page(0xA, eram.data() + (ram_bank * 0x2000));
-            mmu->map_ram_page(0xB, eram.data() + (ram_bank * 0x2000) + 0x1000);
-        }
-    }
+    load_registers(mbc_state);
 }
@@ -18,15 +18,15 @@ class Base : public Imbc {
     Pak& pak;
     Mmu* mmu = nullptr;
 
-    Base(Pak& p, int eram_size) : pak(p) {
-        eram.resize(eram_size);
-        is_eram_enabled = false;
-        rom_bank        = 1;
-        ram_bank        = 0;
-    }
+    Base(Pak& p, int eram_size);
 
     ~Base() override = default;
 
+    // ERAM the mapper hasn't mapped into the Mmu ends up here: disabled RAM,
+    // or registers that aren't plain memory.
+    u8   read_ram(u16 addr) override { return 0xFF; }
+    void write_ram(u16 addr, u8 val) override {}
+
     void set_mmu(Mmu* m) override { this->mmu = m; }
 
     void save_state(std::ostream& out) override;
@@ -34,6 +34,32 @@ class Base : public Imbc {
 
     std::vector<u8> eram;
     bool            is_eram_enabled;
-    int             rom_bank;
-    int             ram_bank;
-};
\ No newline at end of file
+
+   protected:
+    // Start of every ROM and ERAM bank, worked out once so a bank switch is
+    // only a lookup. Both counts are powers of two, so masking a bank number
+    // wraps it the way the unconnected address lines would.
+    std::vector<u8*> rom_banks;
+    std::vector<u8*> ram_banks;
+
+    // The mapper's registers, everything about it that isn't ERAM.
+    // load_registers also has to put its banks back into the memory map.
+    virtual void save_registers(MbcState& state) const {}
+    virtual void load_registers(const MbcState& state) {}
+
+    // Maps `bank` at 0x0000 (slot 0) or 0x4000 (slot 1)
+    void map_rom_bank(int slot, int bank) {
+        u8* ptr = rom_banks[bank & (rom_banks.size() - 1)];
+        for (int i = 0; i < 4; i++) {
+            mmu->map_page(slot * 4 + i, ptr + i * 0x1000);
+        }
+    }
+
+    void map_ram_bank(int bank) { map_ram(ram_banks[bank & (ram_banks.size() - 1)]); }
+
+    // nullptr leaves 0xA000 - 0xBFFF to read_ram/write_ram
+    void map_ram(u8* ptr) {
+        mmu->map_ram_page(0xA, ptr);
+        mmu->map_ram_page(0xB, ptr ? ptr + 0x1000 : nullptr);
+    }
+};
@@ -2,8 +2,10 @@
 
 #include "mbc.h"
 
-class Mbc0 : public Base {
+class Mbc0 final : public Base {
    public:
+    static constexpr MbcKind KIND = MbcKind::Mbc0;
+
     using Base::Base;
 
     void write_rom(u16 addr, u8 val) override {}
@@ -3,8 +3,10 @@
 #include "../pak.h"
 #include "mbc.h"
 
-class Mbc1 : public Base {
+class Mbc1 final : public Base {
    public:
+    static constexpr MbcKind KIND = MbcKind::Mbc1;
+
     using Base::Base;
 
     void write_rom(u16 addr, u8 val) override {
@@ -58,25 +60,8 @@ class Mbc1 : public Base {
             upper_bank_num = bank1_register;
         }
 
-        int rom_bank_mask = (pak.data.size() / 0x4000) - 1;
-
-        lower_bank_num &= rom_bank_mask;
-        upper_bank_num &= rom_bank_mask;
-
-        rom_bank = upper_bank_num;
-
-        u8* rom_data_ptr   = pak.data.data();
-        int lower_offset   = lower_bank_num * 0x4000;
-        mmu->memory_map[0] = rom_data_ptr + lower_offset;
-        mmu->memory_map[1] = rom_data_ptr + lower_offset + 0x1000;
-        mmu->memory_map[2] = rom_data_ptr + lower_offset + 0x2000;
-        mmu->memory_map[3] = rom_data_ptr + lower_offset + 0x3000;
-
-        int upper_offset   = upper_bank_num * 0x4000;
-        mmu->memory_map[4] = rom_data_ptr + upper_offset;
-        mmu->memory_map[5] = rom_data_ptr + upper_offset + 0x1000;
-        mmu->memory_map[6] = rom_data_ptr + upper_offset + 0x2000;
-        mmu->memory_map[7] = rom_data_ptr + upper_offset + 0x3000;
+        map_rom_bank(0, lower_bank_num);
+        map_rom_bank(1, upper_bank_num);
     }
 
     void update_ram_banking() {
@@ -89,22 +74,23 @@ class Mbc1 : public Base {
         }
 
         if (is_eram_enabled && !eram.empty()) {
-            int max_ram_banks = eram.size() / 0x2000;
-            if (max_ram_banks > 0) {
-                current_ram_bank %= max_ram_banks;
-            }
-
-            int ram_offset = current_ram_bank * 0x2000;
-
-            if (ram_offset + 0x2000 > eram.size()) return;
-
-            u8* ram_ptr = eram.data() + ram_offset;
-
-            mmu->map_ram_page(0xA, ram_ptr);
-            mmu->map_ram_page(0xB, ram_ptr + 0x1000);
+            if (ram_banks.empty()) return;
+            map_ram_bank(current_ram_bank);
         } else {
-            mmu->map_ram_page(0xA, nullptr);
-            mmu->map_ram_page(0xB, nullptr);
+            map_ram(nullptr);
         }
     }
+
+    void save_registers(MbcState& state) const override {
+        state.registers[0] = bank1_register;
+        state.registers[1] = bank2_register;
+        state.registers[2] = banking_mode_select;
+    }
+
+    void load_registers(const MbcState& state) override {
+        bank1_register      = state.registers[0];
+        bank2_register      = state.registers[1];
+        banking_mode_select = state.registers[2];
+        update_banking();
+    }
 };
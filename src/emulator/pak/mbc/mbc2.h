@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../pak.h"
+#include "mbc.h"
+
+// 512 half-bytes of RAM on the chip itself, so ERAM is never mapped directly:
+// it repeats every 512 bytes across 0xA000 - 0xBFFF and the upper nibble
+// isn't stored.
+class Mbc2 final : public Base {
+   public:
+    static constexpr MbcKind KIND = MbcKind::Mbc2;
+
+    static constexpr int RAM_SIZE = 512;
+
+    using Base::Base;
+
+    void write_rom(u16 addr, u8 val) override {
+        if (addr >= 0x4000) return;
+
+        // Address bit 8 picks the register
+        if (addr & 0x100) {
+            rom_bank_register = val & 0x0F;
+            if (rom_bank_register == 0) rom_bank_register = 1;
+            update_rom_banking();
+        } else {
+            is_eram_enabled = (val & 0x0F) == 0x0A;
+        }
+    }
+
+    u8 read_ram(u16 addr) override {
+        if (!is_eram_enabled) return 0xFF;
+        return 0xF0 | eram[addr & 0x1FF];
+    }
+
+    void write_ram(u16 addr, u8 val) override {
+        if (is_eram_enabled) eram[addr & 0x1FF] = val & 0x0F;
+    }
+
+   private:
+    u8 rom_bank_register = 1;
+
+    void update_rom_banking() {
+        if (mmu == nullptr) return;
+
+        map_rom_bank(1, rom_bank_register);
+    }
+
+    void save_registers(MbcState& state) const override { state.registers[0] = rom_bank_register; }
+
+    void load_registers(const MbcState& state) override {
+        rom_bank_register = state.registers[0];
+        update_rom_banking();
+    }
+};
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <cstring>
+
+#include "../../scheduler.h"
 #include "../pak.h"
 #include "mbc.h"
 
-class Mbc3 : public Base {
+// The RTC counts emulated cycles, so in-game time is the same on every run
+// and speeds up with the emulator. Building with RTC_WALL_CLOCK makes it
+// follow the host's clock instead.
+class Mbc3 final : public Base {
    public:
-    using Base::Base;
+    static constexpr MbcKind KIND = MbcKind::Mbc3;
+
+    static constexpr u64 CYCLES_PER_SECOND = 4194304;
 
     Mbc3(Pak& p, int eram_size) : Base(p, eram_size) { last_rtc_update = system_clock::now(); }
 
@@ -37,24 +45,70 @@ class Mbc3 : public Base {
         }
     }
 
+    // Only reached with RAM disabled or an RTC register selected
+    u8 read_ram(u16 addr) override {
+        if (!is_eram_enabled) return 0xFF;
+
+        switch (bank2_register) {
+            case 0x08:
+                return latched_s;
+            case 0x09:
+                return latched_m;
+            case 0x0A:
+                return latched_h;
+            case 0x0B:
+                return latched_dl;
+            case 0x0C:
+                return latched_dh;
+            default:
+                return 0xFF;
+        }
+    }
+
+    void write_ram(u16 addr, u8 val) override {
+        if (!is_eram_enabled || bank2_register < 0x08 || bank2_register > 0x0C) return;
+
+        update_rtc();
+        switch (bank2_register) {
+            case 0x08:
+                rtc_s = val & 0x3F;
+                restart_rtc();  // Writing the seconds resets the divider
+                break;
+            case 0x09:
+                rtc_m = val & 0x3F;
+                break;
+            case 0x0A:
+                rtc_h = val & 0x1F;
+                break;
+            case 0x0B:
+                rtc_dl = val;
+                break;
+            case 0x0C:
+                rtc_dh = val & 0xC1;
+                break;
+        }
+    }
+
    private:
     u8 bank1_register = 1;
     u8 bank2_register = 0;
 
-    u8 rtc_s;
-    u8 rtc_m;
-    u8 rtc_h;
-    u8 rtc_dl;
-    u8 rtc_dh;
+    u8 rtc_s  = 0;
+    u8 rtc_m  = 0;
+    u8 rtc_h  = 0;
+    u8 rtc_dl = 0;
+    u8 rtc_dh = 0;  // Bit 0: day bit 8, bit 6: halt, bit 7: day carry
 
-    u8 latched_s;
-    u8 latched_m;
-    u8 latched_h;
-    u8 latched_dl;
-    u8 latched_dh;
+    u8 latched_s  = 0;
+    u8 latched_m  = 0;
+    u8 latched_h  = 0;
+    u8 latched_dl = 0;
+    u8 latched_dh = 0;
 
     u8 latch_sequence_state = 0xFF;
 
+    // Where the current second started, in emulated cycles or host time
+    u64                      rtc_cycle = 0;
     system_clock::time_point last_rtc_update;
 
     void update_rom_banking() {
@@ -64,54 +118,66 @@ class Mbc3 : public Base {
 
         if (target_bank == 0) target_bank = 1;
 
-        int rom_bank_mask = (pak.data.size() / 0x4000) - 1;
-
-        target_bank &= rom_bank_mask;
-        rom_bank = target_bank;
-
-        u8* rom_data_ptr   = pak.data.data();
-        mmu->memory_map[0] = rom_data_ptr;
-        mmu->memory_map[1] = rom_data_ptr + 0x1000;
-        mmu->memory_map[2] = rom_data_ptr + 0x2000;
-        mmu->memory_map[3] = rom_data_ptr + 0x3000;
-
-        int offset         = target_bank * 0x4000;
-        mmu->memory_map[4] = rom_data_ptr + offset;
-        mmu->memory_map[5] = rom_data_ptr + offset + 0x1000;
-        mmu->memory_map[6] = rom_data_ptr + offset + 0x2000;
-        mmu->memory_map[7] = rom_data_ptr + offset + 0x3000;
+        map_rom_bank(0, 0);
+        map_rom_bank(1, target_bank);
     }
 
     void update_ram_banking() {
         if (mmu == nullptr) return;
 
-        if (is_eram_enabled && bank2_register <= 0x03) {
-            if (eram.empty()) {
-                mmu->map_ram_page(0xA, nullptr);
-                mmu->map_ram_page(0xB, nullptr);
-                return;
-            }
-
-            int max_ram_banks    = eram.size() / 0x2000;
-            int current_ram_bank = bank2_register;
-
-            if (max_ram_banks > 0) {
-                current_ram_bank %= max_ram_banks;
-            } else {
-                mmu->map_ram_page(0xA, nullptr);
-                mmu->map_ram_page(0xB, nullptr);
-                return;
-            }
-            int ram_offset = current_ram_bank * 0x2000;
-            u8* ram_ptr    = eram.data() + ram_offset;
-            mmu->map_ram_page(0xA, ram_ptr);
-            mmu->map_ram_page(0xB, ram_ptr + 0x1000);
+        if (is_eram_enabled && bank2_register <= 0x03 && !ram_banks.empty()) {
+            map_ram_bank(bank2_register);
         } else {
-            mmu->map_ram_page(0xA, nullptr);
-            mmu->map_ram_page(0xB, nullptr);
+            map_ram(nullptr);
         }
     }
 
+    void save_registers(MbcState& state) const override {
+        state.registers[0] = bank1_register;
+        state.registers[1] = bank2_register;
+        state.registers[2] = latch_sequence_state;
+
+        state.registers[3] = rtc_s;
+        state.registers[4] = rtc_m;
+        state.registers[5] = rtc_h;
+        state.registers[6] = rtc_dl;
+        state.registers[7] = rtc_dh;
+
+        state.registers[8]  = latched_s;
+        state.registers[9]  = latched_m;
+        state.registers[10] = latched_h;
+        state.registers[11] = latched_dl;
+        state.registers[12] = latched_dh;
+
+        u64 pending = rtc_pending_cycles();
+        std::memcpy(&state.registers[13], &pending, sizeof(pending));
+    }
+
+    void load_registers(const MbcState& state) override {
+        bank1_register       = state.registers[0];
+        bank2_register       = state.registers[1];
+        latch_sequence_state = state.registers[2];
+
+        rtc_s  = state.registers[3];
+        rtc_m  = state.registers[4];
+        rtc_h  = state.registers[5];
+        rtc_dl = state.registers[6];
+        rtc_dh = state.registers[7];
+
+        latched_s  = state.registers[8];
+        latched_m  = state.registers[9];
+        latched_h  = state.registers[10];
+        latched_dl = state.registers[11];
+        latched_dh = state.registers[12];
+
+        u64 pending;
+        std::memcpy(&pending, &state.registers[13], sizeof(pending));
+        restart_rtc(pending);
+
+        update_rom_banking();
+        update_ram_banking();
+    }
+
     void latch_rtc() {
         update_rtc();
         latched_s  = rtc_s;
@@ -121,22 +187,50 @@ class Mbc3 : public Base {
         latched_dh = rtc_dh;
     }
 
+    u64 current_cycle() const {
+        if (mmu == nullptr || mmu->scheduler_ptr == nullptr) return 0;
+        return mmu->scheduler_ptr->now;
+    }
+
+    // Starts counting from `pending` cycles ago
+    void restart_rtc(u64 pending = 0) {
+#ifdef RTC_WALL_CLOCK
+        last_rtc_update = system_clock::now() - microseconds(pending * 1000000 / CYCLES_PER_SECOND);
+#else
+        rtc_cycle = current_cycle() - pending;
+#endif
+    }
+
+    // Time the registers haven't caught up with yet
+    u64 rtc_pending_cycles() const {
+#ifdef RTC_WALL_CLOCK
+        u64 elapsed = duration_cast<microseconds>(system_clock::now() - last_rtc_update).count();
+        return elapsed * CYCLES_PER_SECOND / 1000000;
+#else
+        return current_cycle() - rtc_cycle;
+#endif
+    }
+
     void update_rtc() {
+        // Halted, time stops until the halt bit is cleared again
         if ((rtc_dh & 0x40) != 0) {
+            restart_rtc();
             return;
         }
 
-        auto now     = system_clock::now();
-        auto elapsed = now - last_rtc_update;
-
-        auto      elapsed_seconds_duration = duration_cast<seconds>(elapsed);
-        long long total_seconds            = elapsed_seconds_duration.count();
-
+#ifdef RTC_WALL_CLOCK
+        long long total_seconds = duration_cast<seconds>(system_clock::now() - last_rtc_update).count();
         if (total_seconds < 1) {
             return;
         }
-
         last_rtc_update += seconds(total_seconds);
+#else
+        long long total_seconds = (current_cycle() - rtc_cycle) / CYCLES_PER_SECOND;
+        if (total_seconds < 1) {
+            return;
+        }
+        rtc_cycle += total_seconds * CYCLES_PER_SECOND;
+#endif
 
         long long s = rtc_s + total_seconds;
         rtc_s       = s % 60;
@@ -158,4 +252,4 @@ class Mbc3 : public Base {
             rtc_dh |= 0x80;
         }
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../pak.h"
+#include "mbc.h"
+
+class Mbc5 final : public Base {
+   public:
+    static constexpr MbcKind KIND = MbcKind::Mbc5;
+
+    Mbc5(Pak& p, int eram_size) : Base(p, eram_size) { has_rumble = p.rom.type >= 0x1C; }
+
+    void write_rom(u16 addr, u8 val) override {
+        switch (addr >> 12) {
+            case 0:  // 0x0000 - 0x1FFF
+            case 1: {
+                bool new_state = (val & 0x0F) == 0x0A;
+                if (is_eram_enabled != new_state) {
+                    is_eram_enabled = new_state;
+                    update_ram_banking();
+                }
+            } break;
+            case 2:  // 0x2000 - 0x2FFF
+                rom_bank_low = val;
+                update_rom_banking();
+                break;
+            case 3:  // 0x3000 - 0x3FFF
+                rom_bank_high = val & 0x01;
+                update_rom_banking();
+                break;
+            case 4:  // 0x4000 - 0x5FFF
+            case 5:
+                // Rumble carts wire bit 3 to the motor instead of the RAM chip
+                if (has_rumble) {
+                    rumble            = (val & 0x08) != 0;
+                    ram_bank_register = val & 0x07;
+                } else {
+                    ram_bank_register = val & 0x0F;
+                }
+                update_ram_banking();
+                break;
+        }
+    }
+
+    bool is_rumbling() const { return rumble; }
+
+   private:
+    bool has_rumble;
+    bool rumble = false;
+
+    u8 rom_bank_low      = 1;
+    u8 rom_bank_high     = 0;
+    u8 ram_bank_register = 0;
+
+    // Unlike MBC1/3, bank 0 can be mapped at 0x4000
+    void update_rom_banking() {
+        if (mmu == nullptr) return;
+
+        map_rom_bank(1, (rom_bank_high << 8) | rom_bank_low);
+    }
+
+    void update_ram_banking() {
+        if (mmu == nullptr) return;
+
+        if (is_eram_enabled && !ram_banks.empty()) {
+            map_ram_bank(ram_bank_register);
+        } else {
+            map_ram(nullptr);
+        }
+    }
+
+    void save_registers(MbcState& state) const override {
+        state.registers[0] = rom_bank_low;
+        state.registers[1] = rom_bank_high;
+        state.registers[2] = ram_bank_register;
+        state.registers[3] = rumble;
+    }
+
+    void load_registers(const MbcState& state) override {
+        rom_bank_low      = state.registers[0];
+        rom_bank_high     = state.registers[1];
+        ram_bank_register = state.registers[2];
+        rumble            = state.registers[3];
+        update_rom_banking();
+        update_ram_banking();
+    }
+};
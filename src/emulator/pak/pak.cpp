@@ -10,49 +10,62 @@
 
 #include "mbc/mbc.h"
 #include "mbc/mbc0.h"
+#include "mbc/huc1.h"
 #include "mbc/mbc1.h"
+#include "mbc/mbc2.h"
 #include "mbc/mbc3.h"
+#include "mbc/mbc5.h"
+
+template <typename T>
+void Pak::create_mbc(int eram_size) {
+    mbc      = std::make_unique<T>(*this, eram_size);
+    mbc_kind = T::KIND;
+}
 
 Pak::Pak(std::string rom_path) {
     rom_name = rom_path;
 
-    std::ifstream file(rom_path, std::ios::binary | std::ios::ate);
-
-    if (!file.is_open()) {
-        std::cerr << "Error: Failed to open file: " << rom_path << std::endl;
-        return;
+    // RomImage has already said why
+    image = RomImage::open(rom_path);
+    if (!image) {
+        std::cerr << "FATAL: Could not load ROM: " << rom_path << std::endl;
+        std::exit(EXIT_FAILURE);
     }
 
-    std::streamsize size = file.tellg();
-
-    file.seekg(0, std::ios::beg);
-
-    this->data.resize(size);
-
-    if (file.read(reinterpret_cast<char*>(this->data.data()), size)) {
-        print_header();
-    } else {
-        std::cerr << "Error: Failed to read file data." << std::endl;
-        return;
-    }
+    print_header();
 
     int actual_eram_size = get_eram_size();
 
     switch (rom.type) {
         case 0x00:
-            mbc = std::make_unique<Mbc0>(*this, actual_eram_size);
+            create_mbc<Mbc0>(actual_eram_size);
             break;
         case 0x01:
         case 0x02:
         case 0x03:
-            mbc = std::make_unique<Mbc1>(*this, actual_eram_size);
+            create_mbc<Mbc1>(actual_eram_size);
+            break;
+        case 0x05:
+        case 0x06:
+            create_mbc<Mbc2>(Mbc2::RAM_SIZE);
             break;
         case 0x0F:
         case 0x10:
         case 0x11:
         case 0x12:
         case 0x13:
-            mbc = std::make_unique<Mbc3>(*this, actual_eram_size);
+            create_mbc<Mbc3>(actual_eram_size);
+            break;
+        case 0x19:
+        case 0x1A:
+        case 0x1B:
+        case 0x1C:
+        case 0x1D:
+        case 0x1E:
+            create_mbc<Mbc5>(actual_eram_size);
+            break;
+        case 0xFF:
+            create_mbc<HuC1>(actual_eram_size);
             break;
         default:
             std::cerr << "FATAL: Unsupported MBC type: 0x" << std::hex << (int)rom.type << std::dec << std::endl;
@@ -62,6 +75,8 @@ Pak::Pak(std::string rom_path) {
 }
 
 void Pak::print_header() {
+    const u8* data = image->data();
+
     std::copy_n(&data[0x134], 16, this->rom.title);
 
     u8 license_lo         = data[0x144];
@@ -116,7 +131,8 @@ void Pak::rom_info() {
 }
 
 void Pak::checksum() {
-    u16 calculated_checksum = 0;
+    const u8* data                = image->data();
+    u16       calculated_checksum = 0;
 
     for (int i = 0x134; i <= 0x14C; i++) {
         calculated_checksum = calculated_checksum - data[i] - 1;
@@ -5,19 +5,25 @@
 
 #include "mbc/Imbc.h"
 #include "rom.h"
+#include "rom_image.h"
 
 class Pak {
    public:
     Pak(std::string rom_path);
 
     std::unique_ptr<Imbc> mbc;
+    MbcKind               mbc_kind;  // The class of `mbc`
     Rom                   rom;
 
-    std::vector<u8> data;
-    std::string     rom_name;
+    std::shared_ptr<RomImage> image;  // Shared with every other Pak of the same file
+    std::string               rom_name;
 
     void print_header();
     void rom_info();
     void checksum();
     int  get_eram_size();
+
+   private:
+    template <typename T>
+    void create_mbc(int eram_size);
 };
\ No newline at end of file
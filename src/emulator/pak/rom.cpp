@@ -43,7 +43,8 @@ const std::unordered_map<u8, std::string> Rom::RomTypes = {{0x00, "ROM ONLY"},
                                                            {0x1F, "0x1F ???"},
                                                            {0x20, "MBC6"},
                                                            {0x21, "0x21 ???"},
-                                                           {0x22, "MBC7+SENSOR+RUMBLE+RAM+BATTERY"}};
+                                                           {0x22, "MBC7+SENSOR+RUMBLE+RAM+BATTERY"},
+                                                           {0xFF, "HuC1+RAM+BATTERY"}};
 
 const std::unordered_map<u8, std::string> Rom::LicenseCodes = {{0x00, "None"},
                                                                {0x01, "Nintendo R&D1"},
@@ -0,0 +1,171 @@
+#include "rom_image.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<RomImage> RomImage::open(const std::string& path) {
+    static std::mutex                                               mutex;
+    static std::unordered_map<std::string, std::weak_ptr<RomImage>> images;
+
+    std::error_code ec;
+    std::string     key = std::filesystem::canonical(path, ec).string();
+    if (ec) key = path;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (std::shared_ptr<RomImage> image = images[key].lock()) {
+        return image;
+    }
+
+    std::shared_ptr<RomImage> image(new RomImage());
+    if (!image->load(key)) {
+        images.erase(key);
+        return nullptr;
+    }
+
+    images[key] = image;
+    return image;
+}
+
+RomImage::~RomImage() {
+    if (!mapped) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(mapping);
+#else
+    munmap(base, bytes);
+#endif
+}
+
+size_t RomImage::padded_size(size_t file_bytes) {
+    size_t banks = 2;
+    while (banks * BANK_SIZE < file_bytes) {
+        banks *= 2;
+    }
+    return banks * BANK_SIZE;
+}
+
+bool RomImage::load(const std::string& path) { return map_file(path) || read_file(path); }
+
+#ifdef _WIN32
+bool RomImage::map_file(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    file_bytes = file_size.QuadPart;
+    bytes      = padded_size(file_bytes);
+
+    // A view of a read-only file can't reach past its end, so only images
+    // that need no padding are mapped. The rest are read into a buffer.
+    if (file_bytes != bytes) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE file_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (file_mapping == nullptr) return false;
+
+    void* view = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(file_mapping);
+        return false;
+    }
+
+    mapping = file_mapping;
+    base    = static_cast<u8*>(view);
+    mapped  = true;
+    return true;
+}
+#else
+bool RomImage::map_file(const std::string& path) {
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    file_bytes = st.st_size;
+    bytes      = padded_size(file_bytes);
+
+    // Reserve the padded size as zero pages, then put the file over the start
+    void* reserved = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    if (file_bytes > 0 && mmap(reserved, file_bytes, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(reserved, bytes);
+        ::close(fd);
+        return false;
+    }
+    ::close(fd);
+
+#ifdef MADV_HUGEPAGE
+    // Just a hint, the kernel may or may not back the image with huge pages
+    if (bytes >= HUGE_PAGE_SIZE) {
+        madvise(reserved, bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    base   = static_cast<u8*>(reserved);
+    mapped = true;
+    return true;
+}
+#endif
+
+bool RomImage::read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if (!file.is_open()) {
+        std::cerr << "Error: Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    file_bytes = size;
+    bytes      = padded_size(file_bytes);
+    buffer.assign(bytes, 0);
+
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) {
+        std::cerr << "Error: Failed to read file data." << std::endl;
+        return false;
+    }
+
+    base = buffer.data();
+    return true;
+}
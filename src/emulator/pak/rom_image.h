@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// A ROM file mapped read-only into memory, padded with zeros to a power of
+// two number of 16K banks (at least two), so masking a bank number with
+// `size() / 0x4000 - 1` always lands inside the image.
+//
+// Images are shared: opening a file that another Pak in the process already
+// has open returns the same mapping instead of a second copy.
+class RomImage {
+   public:
+    static constexpr size_t BANK_SIZE = 0x4000;
+
+    // Returns nullptr (after reporting why) if the file can't be read
+    static std::shared_ptr<RomImage> open(const std::string& path);
+
+    RomImage(const RomImage&)            = delete;
+    RomImage& operator=(const RomImage&) = delete;
+    ~RomImage();
+
+    // Not const because the memory map deals in u8*, but the mapping is
+    // read-only: ROM writes go to the MBC and never reach it.
+    u8* data() const { return base; }
+
+    size_t size() const { return bytes; }
+    size_t file_size() const { return file_bytes; }
+
+    u8 operator[](size_t i) const { return base[i]; }
+
+   private:
+    RomImage() = default;
+
+    bool load(const std::string& path);
+    bool map_file(const std::string& path);
+    bool read_file(const std::string& path);
+
+    static size_t padded_size(size_t file_bytes);
+
+    u8*    base       = nullptr;
+    size_t bytes      = 0;
+    size_t file_bytes = 0;
+    bool   mapped     = false;
+
+    std::vector<u8> buffer;  // Backing memory when the file couldn't be mapped
+
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+
+#include "raylib.h"
+#include "tile_cache.h"
+
+struct Sprite {
+    u8 y;
+    u8 x;
+    u8 tile_index;
+    u8 attributes;
+    u8 oam_index;
+};
+
+// What the renderer needs from LCDC and the palettes, worked out when they
+// are written instead of being decoded again for every tile or pixel.
+struct RenderState {
+    // Palette entries in a drawn line, indices into `colors`
+    static constexpr u8 BG_COLORS    = 0;
+    static constexpr u8 OBP0_COLORS  = 4;
+    static constexpr u8 OBP1_COLORS  = 8;
+    static constexpr u8 BLANK_COLORS = 12;  // BG disabled
+
+    bool lcd_enabled;
+    bool bg_enabled;
+    bool sprites_enabled;
+    bool window_enabled;
+    bool signed_tile_data;  // BG and window tile indices are i8 from 0x9000
+    int  sprite_height;
+
+    int bg_map;  // Tile map 0 at 0x9800 or 1 at 0x9C00
+    int window_map;
+
+    std::array<Color, 16> colors;  // Palettes, then white
+};
+
+// Everything about one line the fast renderer needs, taken at the end of
+// mode 3 so the line can be drawn later, away from the registers.
+struct LineRecord {
+    static constexpr int NO_WINDOW = -1;
+
+    int         y;
+    u8          scx;
+    u8          scy;
+    int         window_x;     // WX - 7
+    int         window_line;  // Line of the window shown, or NO_WINDOW
+    RenderState state;
+    int         sprite_count;
+    u64         vram_writes;  // VRAM writes made before the line, see RenderWorker
+
+    std::array<Sprite, 10> sprites;  // Drawing priority order
+};
+
+// The decoded row of `s` on line `y`, mirrored if it is X-flipped
+inline const u8* sprite_row(TileCache& tiles, const Sprite& s, int y, int height) {
+    u8 pixel_y = y - s.y;  // s.y wraps for sprites partly above the screen
+    if (s.attributes & 0x40) {
+        pixel_y = (height - 1) - pixel_y;
+    }
+
+    // 8x16 sprites special case
+    u8 tile_index = (height == 16) ? (s.tile_index & 0xFE) : s.tile_index;
+
+    return (s.attributes & 0x20) ? tiles.flipped_row(tile_index, pixel_y) : tiles.row(tile_index, pixel_y);
+}
@@ -0,0 +1,72 @@
+#include "map_cache.h"
+
+#include <cstring>
+
+#include "tile_cache.h"
+
+MapCache::MapCache(const u8* v, TileCache& t) : vram(v), tiles(t) { invalidate_all(); }
+
+void MapCache::invalidate_all() {
+    for (auto& mode : dirty_cells) {
+        for (auto& map : mode) {
+            map.fill(~0u);
+        }
+    }
+    changed_tiles.fill(0);
+    tiles_changed = false;
+
+    for (int map = 0; map < 2; map++) {
+        std::memcpy(indices[map].data(), vram + 0x1800 + map * 0x400, 1024);
+        for (auto& cells : cells_using[map]) {
+            cells.fill(0);
+        }
+        for (int cell = 0; cell < 1024; cell++) {
+            cells_using[map][indices[map][cell]][cell / 32] |= 1u << (cell & 31);
+        }
+    }
+}
+
+// Turns the tiles written since the last call into the map cells that show
+// them, for both ways of addressing tile data. Tiles 0-127 are only
+// reachable unsigned, 256-383 only signed, 128-255 both ways.
+void MapCache::find_changed_cells() {
+    for (int word = 0; word < 6; word++) {
+        u64 bits = changed_tiles[word];
+        for (int i = 0; bits != 0; i++, bits >>= 1) {
+            if ((bits & 1) == 0) continue;
+
+            int tile = word * 64 + i;
+            if (tile < 256) mark_cells_using(0, static_cast<u8>(tile));
+            if (tile >= 128) mark_cells_using(1, static_cast<u8>(tile - 256));
+        }
+    }
+
+    changed_tiles.fill(0);
+    tiles_changed = false;
+}
+
+void MapCache::mark_cells_using(int mode, u8 tile_index) {
+    for (int map = 0; map < 2; map++) {
+        const auto& cells = cells_using[map][tile_index];
+        auto&       dirty = dirty_cells[mode][map];
+        for (int row = 0; row < 32; row++) {
+            dirty[row] |= cells[row];
+        }
+    }
+}
+
+void MapCache::draw_cells(int map, int mode, int row, u32 cells) {
+    const u8* tile_map = vram + 0x1800 + map * 0x400 + row * 32;
+    u8*       out      = &bitmaps[mode][map][row * 8 * SIZE];
+
+    for (int x = 0; x < 32; x++) {
+        if ((cells & (1u << x)) == 0) continue;
+
+        u8  tile_index = tile_map[x];
+        int tile       = mode ? 256 + static_cast<i8>(tile_index) : tile_index;
+
+        for (int y = 0; y < 8; y++) {
+            std::memcpy(&out[y * SIZE + x * 8], tiles.row(tile, y), 8);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+
+class TileCache;
+
+// Both 32x32 tile maps drawn out as 256x256 bitmaps of colour indices, so a
+// BG or window line is copied out of them instead of being put together
+// tile by tile. There is one pair of bitmaps for each way LCDC bit 4 can
+// address tile data, games that switch it mid frame don't redraw anything.
+//
+// Redrawn lazily per 8x8 cell: the Mmu reports writes to the tile maps and
+// to tile data, line() redraws the cells of the row it returns that were
+// touched, or that show a tile that was. Which cells show a tile is kept
+// up as the maps are written, so a tile write only costs the cells using it.
+class MapCache {
+   public:
+    static constexpr int SIZE = 256;
+
+    MapCache(const u8* vram, TileCache& tiles);
+
+    // Row `y` of tile map `map` (0 at 0x9800, 1 at 0x9C00), SIZE pixels
+    inline const u8* line(int map, bool signed_tile_data, u8 y) {
+        if (tiles_changed) find_changed_cells();
+
+        int   mode  = signed_tile_data ? 1 : 0;
+        u32&  dirty = dirty_cells[mode][map][y / 8];
+        auto& image = bitmaps[mode][map];
+
+        if (dirty) {
+            draw_cells(map, mode, y / 8, dirty);
+            dirty = 0;
+        }
+        return &image[y * SIZE];
+    }
+
+    // A byte of a tile map, 0x9800 - 0x9FFF, after it is written to `vram`
+    inline void invalidate_map(u16 addr) {
+        int map  = (addr >> 10) & 1;
+        int cell = addr & 0x3FF;
+        u32 bit  = 1u << (cell & 31);
+        dirty_cells[0][map][cell / 32] |= bit;
+        dirty_cells[1][map][cell / 32] |= bit;
+
+        u8& old_index = indices[map][cell];
+        u8  new_index = vram[addr - 0x8000];
+        if (old_index != new_index) {
+            cells_using[map][old_index][cell / 32] &= ~bit;
+            cells_using[map][new_index][cell / 32] |= bit;
+            old_index = new_index;
+        }
+    }
+
+    // A byte of tile data, 0x8000 - 0x97FF
+    inline void invalidate_tile(u16 addr) {
+        int tile = (addr - 0x8000) >> 4;
+        changed_tiles[tile >> 6] |= 1ull << (tile & 63);
+        tiles_changed = true;
+    }
+
+    void invalidate_all();
+
+   private:
+    const u8*  vram;
+    TileCache& tiles;
+
+    // [unsigned, signed tile data][map]
+    std::array<std::array<std::array<u8, SIZE * SIZE>, 2>, 2> bitmaps;
+    std::array<std::array<std::array<u32, 32>, 2>, 2>         dirty_cells;
+
+    // The tile index in each cell, as `cells_using` knows it, and the cells
+    // of each map holding each tile index, one bit per cell like `dirty_cells`
+    std::array<std::array<u8, 1024>, 2>                 indices;
+    std::array<std::array<std::array<u32, 32>, 256>, 2> cells_using;
+
+    // Tiles written since the cells showing them were last looked for
+    std::array<u64, 6> changed_tiles;
+    bool               tiles_changed;
+
+    void find_changed_cells();
+    void mark_cells_using(int mode, u8 tile_index);
+    void draw_cells(int map, int mode, int row, u32 cells);
+};
@@ -1,6 +1,7 @@
 #include "ppu.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -8,19 +9,45 @@
 
 #include "../emulator.h"
 
-Ppu::Ppu(Mmu& m) : mmu(m) {
+Ppu::Ppu(Mmu& m, Scheduler& s, Renderer r)
+    : mmu(m),
+      scheduler(s),
+      tile_cache(m.ram.vram.data()),
+      sprite_index(m.ram.oam.data()),
+      kernels(scanline_kernels()),
+      renderer(r) {
+    sync_fn = renderer == Renderer::Accurate ? &Ppu::sync_with<Renderer::Accurate> : &Ppu::sync_with<Renderer::Fast>;
+
     scanline_counter    = 0;
     window_line_counter = 0;
     sprite_count        = 0;
     prev_signal         = false;
     mode_3_extra_cycles = 0;
+    last_sync           = scheduler.now;
+    fifo                = PixelFifo{};
+
+    scheduler.schedule(Event::Ppu, last_sync + 1);
 
+    index_frame.fill(RenderState::BLANK_COLORS);
+    for (std::array<Color, 16>& colors : line_colors) {
+        colors.fill(WHITE);
+    }
     frame_buffer.fill(WHITE);
+    frame_buffer_stale = false;
+
+    // The palettes start out as they are until something writes them
+    for (int i = 0; i < 4; ++i) {
+        DmgColor c                                   = default_colors[i];
+        render.colors[RenderState::BG_COLORS + i]    = {c.r, c.g, c.b, 255};
+        render.colors[RenderState::OBP0_COLORS + i]  = {c.r, c.g, c.b, 255};
+        render.colors[RenderState::OBP1_COLORS + i]  = {c.r, c.g, c.b, 255};
+        render.colors[RenderState::BLANK_COLORS + i] = WHITE;
+    }
+    update_lcdc();
 
-    for (size_t i = 0; i < 4; ++i) {
-        bg_palette.colors[i]   = default_colors[i];
-        obj_palette0.colors[i] = default_colors[i];
-        obj_palette1.colors[i] = default_colors[i];
+    if (renderer != Renderer::Accurate) {
+        worker = std::make_unique<RenderWorker>(mmu.ram.vram.data(), index_frame.data(), line_colors.data(),
+                                                renderer == Renderer::Batched);
     }
 }
 
@@ -35,17 +62,97 @@ void Ppu::load_state(const PpuState& state) {
     window_line_counter = state.window_line_counter;
     prev_signal         = state.prev_signal;
 
-    update_palettes();
-}
+    update_lcdc();
+    update_palette(0x47);
+    update_palette(0x48);
+    update_palette(0x49);
 
-const std::array<Color, Ppu::SCREEN_WIDTH * Ppu::SCREEN_HEIGHT>& Ppu::get_frame_buffer() const { return frame_buffer; }
+    if (worker) {
+        worker->reset_vram(mmu.ram.vram.data());
+    }
 
-void Ppu::tick(u8 cycles) {
+    fifo.window_y_reached = mmu.wy() <= mmu.ly();
+    if (get_mode() == Mode::Drawing) {
+        start_fifo_line();
+    }
+
+    last_sync = scheduler.now;
+    scheduler.schedule(Event::Ppu, last_sync + 1);
+}
+
+const std::array<Color, Ppu::SCREEN_WIDTH * Ppu::SCREEN_HEIGHT>& Ppu::get_frame_buffer() const {
     ZoneScoped;
 
-    bool lcd_enabled = is_lcd_enabled();
+    if (frame_buffer_stale) {
+        if (worker) worker->wait();
+
+        for (int y = 0; y < SCREEN_HEIGHT; y++) {
+            kernels.to_rgba(&index_frame[y * SCREEN_WIDTH], line_colors[y].data(), &frame_buffer[y * SCREEN_WIDTH],
+                            SCREEN_WIDTH);
+        }
+        frame_buffer_stale = false;
+    }
+
+    return frame_buffer;
+}
+
+void Ppu::sync() { (this->*sync_fn)(); }
+
+template <Renderer R>
+void Ppu::sync_with() {
+    tick<R>(scheduler.now - last_sync);
+    last_sync = scheduler.now;
+
+    schedule_next_transition<R>();
+}
+
+void Ppu::sync_for_write() {
+    sync();
+    scheduler.schedule(Event::Ppu, scheduler.now + 1);
+}
+
+void Ppu::sync_for_render() {
+    if (renderer == Renderer::Accurate) {
+        sync();
+    }
+}
+
+// Nothing the CPU can see changes between transitions, so the next sync
+// only has to happen once scanline_counter reaches the current mode's end.
+// The accurate renderer can't tell when mode 3 ends ahead of time, but it
+// puts out at most a pixel per dot, so it can't be before the rest of them.
+template <Renderer R>
+void Ppu::schedule_next_transition() {
+    if (!render.lcd_enabled) {
+        scheduler.cancel(Event::Ppu);
+        return;
+    }
+
+    int remaining;
+    switch (get_mode()) {
+        case Mode::OamScan:
+            remaining = OAM_SCAN_CYCLES - scanline_counter;
+            break;
+        case Mode::Drawing:
+            if constexpr (R == Renderer::Accurate) {
+                remaining = fifo.dot + (SCREEN_WIDTH - fifo.x) - scanline_counter;
+            } else {
+                remaining = OAM_SCAN_CYCLES + VRAM_READ_CYCLES + (mmu.scx() % 8) + mode_3_extra_cycles - scanline_counter;
+            }
+            break;
+        default:
+            remaining = CYCLES_PER_SCANLINE - scanline_counter;
+            break;
+    }
 
-    if (lcd_enabled) {
+    scheduler.schedule(Event::Ppu, last_sync + std::max(remaining, 1));
+}
+
+template <Renderer R>
+void Ppu::tick(int cycles) {
+    ZoneScoped;
+
+    if (render.lcd_enabled) {
         scanline_counter += cycles;
 
         switch (get_mode()) {
@@ -54,15 +161,25 @@ void Ppu::tick(u8 cycles) {
                     oam_scan();
                     mode_3_extra_cycles = sprite_count * 6;
                     set_mode(Mode::Drawing);
+                    if constexpr (R == Renderer::Accurate) {
+                        start_fifo_line();
+                    }
                 }
                 break;
-            case Mode::Drawing: {
-                int total_mode_3_time = VRAM_READ_CYCLES + (mmu.scx() % 8) + mode_3_extra_cycles;
-                if (scanline_counter >= OAM_SCAN_CYCLES + total_mode_3_time) {
-                    set_mode(Mode::HBlank);
-                    render_scanline();
+            case Mode::Drawing:
+                if constexpr (R == Renderer::Accurate) {
+                    if (run_fifo()) {
+                        set_mode(Mode::HBlank);
+                        finish_fifo_line();
+                    }
+                } else {
+                    int total_mode_3_time = VRAM_READ_CYCLES + (mmu.scx() % 8) + mode_3_extra_cycles;
+                    if (scanline_counter >= OAM_SCAN_CYCLES + total_mode_3_time) {
+                        set_mode(Mode::HBlank);
+                        render_scanline();
+                    }
                 }
-            } break;
+                break;
             case Mode::HBlank:
                 if (scanline_counter >= CYCLES_PER_SCANLINE) {
                     scanline_counter = 0;
@@ -71,6 +188,9 @@ void Ppu::tick(u8 cycles) {
                     if (mmu.ly() >= VISIBLE_SCANLINES) {
                         set_mode(Mode::VBlank);
                         mmu.request_interrupt(InterruptType::VBlank);
+                        if constexpr (R == Renderer::Fast) {
+                            worker->end_frame();
+                        }
                     } else {
                         set_mode(Mode::OamScan);
                     }
@@ -102,170 +222,223 @@ void Ppu::tick(u8 cycles) {
     update_stat_interrupt();
 }
 
+// Describes the line for the render worker, which draws it while the
+// emulation carries on
 void Ppu::render_scanline() {
-    render_background_line();
-    render_window_line();
-    render_sprite_line();
-}
-
-void Ppu::render_background_line() {
-    int y             = mmu.ly();
-    int canvas_offset = y * Ppu::SCREEN_WIDTH;
-
-    if (!is_bit(0, mmu.lcdc())) {
-        for (int x = 0; x < Ppu::SCREEN_WIDTH; x++) {
-            frame_buffer[canvas_offset + x] = WHITE;
-        }
-        return;
-    }
-
-    u8 bg_y = (y + mmu.scy()) & 0xFF;
-
-    u8 tile_row = bg_y & 7;
-
-    u16 tile_map_base = get_tile_map();
-
-    for (int x = 0; x < Ppu::SCREEN_WIDTH; x++) {
-        u8 bg_x = (x + mmu.scx()) & 0xFF;
-
-        u16 tile_x = bg_x / 8;
-        u16 tile_y = bg_y / 8;
-
-        u16 tile_map_addr = tile_map_base + (tile_y * 32) + tile_x;
-        u8  tile_index    = mmu.ppu_read_u8(tile_map_addr);
-
-        u16 tile_data_addr = get_tile_data_address(tile_index);
-
-        u16 tile_row_addr = tile_data_addr + (tile_row * 2);
-        u8  byte1         = mmu.ppu_read_u8(tile_row_addr);
-        u8  byte2         = mmu.ppu_read_u8(tile_row_addr + 1);
-
-        u8 tile_col = bg_x & 7;
+    ZoneScoped;
 
-        int color_bit = 7 - tile_col;
+    LineRecord& r  = worker->next_line();
+    r.y            = mmu.ly();
+    r.scx          = mmu.scx();
+    r.scy          = mmu.scy();
+    r.window_x     = mmu.wx() - 7;
+    r.window_line  = is_window() ? window_line_counter++ : LineRecord::NO_WINDOW;
+    r.state        = render;
+    r.sprite_count = sprite_count;
+    std::copy_n(sprite_buffer.begin(), sprite_count, r.sprites.begin());
+    worker->submit_line();
+
+    frame_buffer_stale = true;
+}
 
-        u8 color_id = (((byte2 >> color_bit) & 1) << 1) | ((byte1 >> color_bit) & 1);
+// =============================================================
+//  Pixel FIFO
+// =============================================================
+// The accurate renderer. Runs the background fetcher and the FIFOs a dot at
+// a time and reads the registers when the hardware would, so a write in the
+// middle of a line changes the pixels after it, and mode 3 is over when the
+// last pixel is out instead of after a fixed estimate.
+//
+// Pixels go into index_frame as shades (0-3) with the palettes already
+// applied, since they can change part way along.
+
+void Ppu::start_fifo_line() {
+    fifo.step        = PixelFifo::Step::Tile;
+    fifo.step_dots   = 0;
+    fifo.fetch_x     = 0;
+    fifo.stall       = 6;  // The first tile gets fetched twice
+    fifo.bg_size     = 0;
+    fifo.obj_head    = 0;
+    fifo.dot         = OAM_SCAN_CYCLES;
+    fifo.x           = 0;
+    fifo.discard     = mmu.scx() & 7;
+    fifo.next_sprite = 0;
+    fifo.sprite_dots = 0;
+    fifo.in_window   = false;
+    fifo.obj.fill({});
+
+    if (mmu.ly() == 0) fifo.window_y_reached = false;
+    if (mmu.ly() == mmu.wy()) fifo.window_y_reached = true;
+}
 
-        DmgColor c = bg_palette.colors[color_id];
+// Runs up to scanline_counter, true once the last pixel is out
+bool Ppu::run_fifo() {
+    while (fifo.dot < scanline_counter) {
+        fifo_dot();
+        fifo.dot++;
 
-        frame_buffer[canvas_offset + x] = {c.r, c.g, c.b, 255};
+        if (fifo.x == SCREEN_WIDTH) {
+            return true;
+        }
     }
+    return false;
 }
 
-void Ppu::render_sprite_line() {
-    if (!is_bit(1, mmu.lcdc())) {
+void Ppu::fifo_dot() {
+    if (fifo.stall > 0) {
+        fifo.stall--;
         return;
     }
 
-    // Sorting sprites in order of priority, fixes the mole issue on acid test.
-    std::sort(sprite_buffer.begin(), sprite_buffer.begin() + sprite_count, [](const Sprite& a, const Sprite& b) {
-        if (a.x != b.x) {
-            return a.x < b.x;
+    if (fifo.sprite_dots > 0) {
+        if (--fifo.sprite_dots == 0) {
+            mix_sprite(sprite_buffer[fifo.next_sprite++]);
         }
-        return a.oam_index < b.oam_index;
-    });
-
-    int y_size   = sprite_size();
-    int scanline = mmu.ly();
-
-    for (int i = sprite_count - 1; i >= 0; --i) {
-        const Sprite& s = sprite_buffer[i];
+        return;
+    }
 
-        if (s.x == 0 || s.x >= 168) {
-            continue;
-        }
+    // Throws away what the FIFO has and starts fetching window tiles
+    if (!fifo.in_window && window_starts()) {
+        fifo.in_window = true;
+        fifo.bg_size   = 0;
+        fifo.step      = PixelFifo::Step::Tile;
+        fifo.step_dots = 0;
+        fifo.fetch_x   = 0;
+        fifo.discard   = fifo.x == 0 ? std::max(7 - mmu.wx(), 0) : 0;
+    }
 
-        int pixel_y = scanline - s.y;
-        if (is_y_flipped(s.attributes)) {
-            pixel_y = (y_size - 1) - pixel_y;
+    // A sprite starts here. The fetcher gets to finish the tile it is on,
+    // and put it in the FIFO if that's empty, then the sprite takes 6 dots.
+    if (render.sprites_enabled && fifo.next_sprite < sprite_count && sprite_buffer[fifo.next_sprite].x <= fifo.x + 8) {
+        bool fetching = fifo.step != PixelFifo::Step::Push &&
+                        (fifo.step != PixelFifo::Step::Tile || fifo.step_dots > 0);
+        if (fetching || fifo.bg_size == 0) {
+            fetch_step();
+        } else {
+            fifo.sprite_dots = 5;
         }
+        return;
+    }
 
-        // 8x16 sprites special case
-        u8 tile_index = (y_size == 16) ? (s.tile_index & 0xFE) : s.tile_index;
-
-        u16 tile_addr = 0x8000 + (tile_index * 16);
-        u8  byte1     = mmu.ppu_read_u8(tile_addr + (pixel_y * 2));
-        u8  byte2     = mmu.ppu_read_u8(tile_addr + (pixel_y * 2) + 1);
-
-        Palette& pal = is_bit(4, s.attributes) ? obj_palette1 : obj_palette0;
-
-        for (int pixel_x = 0; pixel_x < 8; ++pixel_x) {
-            int screen_x = (s.x - 8) + pixel_x;
-
-            if (screen_x < 0 || screen_x >= SCREEN_WIDTH) {
-                continue;
-            }
-
-            int color_bit = is_x_flipped(s.attributes) ? pixel_x : (7 - pixel_x);
-
-            u8 color_id = (((byte2 >> color_bit) & 1) << 1) | ((byte1 >> color_bit) & 1);
-
-            if (color_id == 0) {
-                continue;
-            }
+    fetch_step();
+    shift_pixel();
+}
 
-            if (is_bit(7, s.attributes)) {
-                Color    bgColor    = frame_buffer[scanline * SCREEN_WIDTH + screen_x];
-                DmgColor bg_color_0 = bg_palette.colors[0];
-                if (bgColor.r != bg_color_0.r || bgColor.g != bg_color_0.g || bgColor.b != bg_color_0.b) {
-                    continue;
-                }
+void Ppu::fetch_step() {
+    switch (fifo.step) {
+        case PixelFifo::Step::Tile: {
+            if (++fifo.step_dots < 2) return;
+
+            int map, map_y, column;
+            if (fifo.in_window) {
+                map    = render.window_map;
+                map_y  = window_line_counter & 0xFF;
+                column = fifo.fetch_x & 31;
+            } else {
+                map    = render.bg_map;
+                map_y  = (mmu.ly() + mmu.scy()) & 0xFF;
+                column = ((mmu.scx() >> 3) + fifo.fetch_x) & 31;
             }
 
-            DmgColor c = pal.colors[color_id];
-
-            frame_buffer[scanline * SCREEN_WIDTH + screen_x] = {c.r, c.g, c.b, 255};
-        }
+            u8 tile_index  = mmu.ram.vram[0x1800 + map * 0x400 + (map_y / 8) * 32 + column];
+            fifo.tile      = render.signed_tile_data ? 256 + static_cast<i8>(tile_index) : tile_index;
+            fifo.tile_y    = map_y & 7;
+            fifo.step      = PixelFifo::Step::DataLow;
+            fifo.step_dots = 0;
+        } break;
+        case PixelFifo::Step::DataLow:
+            if (++fifo.step_dots < 2) return;
+            fifo.step      = PixelFifo::Step::DataHigh;
+            fifo.step_dots = 0;
+            break;
+        case PixelFifo::Step::DataHigh:
+            if (++fifo.step_dots < 2) return;
+            fifo.fetched   = tile_cache.row(fifo.tile, fifo.tile_y);
+            fifo.step      = PixelFifo::Step::Push;
+            fifo.step_dots = 0;
+            break;
+        case PixelFifo::Step::Push:
+            // Waits until the FIFO is empty
+            if (fifo.bg_size > 0) return;
+            std::memcpy(fifo.bg.data(), fifo.fetched, 8);
+            fifo.bg_size = 8;
+            fifo.fetch_x++;
+            fifo.step = PixelFifo::Step::Tile;
+            break;
     }
 }
 
-void Ppu::render_window_line() {
-    if (!is_window()) {
+void Ppu::shift_pixel() {
+    if (fifo.bg_size == 0) {
         return;
     }
 
-    int wx            = mmu.wx() - 7;
-    int y             = mmu.ly();
-    int canvas_offset = y * Ppu::SCREEN_WIDTH;
-
-    u16 tile_map_base = get_window_tile_map();
+    u8 color = fifo.bg[8 - fifo.bg_size--];
+    if (fifo.discard > 0) {
+        fifo.discard--;
+        return;
+    }
 
-    int window_y = window_line_counter;
+    ObjPixel& obj = fifo.obj[fifo.obj_head];
+    fifo.obj_head = (fifo.obj_head + 1) & 7;
 
-    for (int x = 0; x < Ppu::SCREEN_WIDTH; x++) {
-        if (x < wx) {
-            continue;  // Don't need offscreen pixels
-        }
+    // With the BG off it's white, and sprites behind it show everywhere
+    if (!render.bg_enabled) color = 0;
 
-        int window_x = x - wx;
+    u8 shade = render.bg_enabled ? (mmu.bgp() >> (color * 2)) & 3 : 0;
+    if (obj.color != 0 && render.sprites_enabled && !(obj.behind_bg && color != 0)) {
+        u8 obp = obj.obp1 ? mmu.obp1() : mmu.obp0();
+        shade  = (obp >> (obj.color * 2)) & 3;
+    }
 
-        u16 tile_x = window_x / 8;
-        u16 tile_y = window_y / 8;
+    obj                                             = {};
+    index_frame[mmu.ly() * SCREEN_WIDTH + fifo.x++] = shade;
+}
 
-        u16 tile_map_addr = tile_map_base + (tile_y * 32) + tile_x;
-        u8  tile_index    = mmu.ppu_read_u8(tile_map_addr);
+// Fills the slots of the object FIFO no sprite before it has taken. Sprites
+// come in drawing priority order, so the first one to get a pixel keeps it.
+void Ppu::mix_sprite(const Sprite& s) {
+    const u8* row = sprite_row(tile_cache, s, mmu.ly(), render.sprite_height);
 
-        u16 tile_data_addr = get_tile_data_address(tile_index);
+    for (int i = 0; i < 8; i++) {
+        int slot = s.x - 8 + i - fifo.x;
+        if (slot < 0 || row[i] == 0) continue;
 
-        u8  tile_row      = window_y % 8;
-        u16 tile_row_addr = tile_data_addr + (tile_row * 2);
-        u8  byte1         = mmu.ppu_read_u8(tile_row_addr);
-        u8  byte2         = mmu.ppu_read_u8(tile_row_addr + 1);
+        ObjPixel& pixel = fifo.obj[(fifo.obj_head + slot) & 7];
+        if (pixel.color == 0) {
+            pixel = {row[i], is_bit(4, s.attributes), is_bit(7, s.attributes)};
+        }
+    }
+}
 
-        u8  tile_col  = window_x % 8;
-        int color_bit = 7 - tile_col;
-        u8  color_id  = (((byte2 >> color_bit) & 1) << 1) | ((byte1 >> color_bit) & 1);
+void Ppu::finish_fifo_line() {
+    int y = mmu.ly();
+    for (int i = 0; i < 4; i++) {
+        DmgColor c        = default_colors[i];
+        line_colors[y][i] = {c.r, c.g, c.b, 255};
+    }
+    frame_buffer_stale = true;
 
-        DmgColor c                      = bg_palette.colors[color_id];
-        frame_buffer[canvas_offset + x] = {c.r, c.g, c.b, 255};
+    if (fifo.in_window) {
+        window_line_counter++;
     }
+}
 
-    window_line_counter++;
+bool Ppu::window_starts() {
+    return render.window_enabled && fifo.window_y_reached && mmu.wx() < SCREEN_WIDTH + 7 && fifo.x + 7 >= mmu.wx();
 }
 
 Mode Ppu::get_mode() { return static_cast<Mode>(mmu.stat() & 0x3); }
 
-void Ppu::set_mode(Mode m) { mmu.stat() = static_cast<u8>(m) | mmu.stat() & 0b11111100; }
+void Ppu::set_mode(Mode m) {
+    bool was_drawing = get_mode() == Mode::Drawing;
+    mmu.stat()       = static_cast<u8>(m) | mmu.stat() & 0b11111100;
+
+    // VRAM is off limits to the CPU in mode 3
+    if (was_drawing != (m == Mode::Drawing)) {
+        mmu.update_vram_pages();
+    }
+}
 
 void Ppu::update_stat_interrupt() {
     bool lyc_interrupt_enabled    = is_bit(6, mmu.stat());
@@ -294,62 +467,75 @@ void Ppu::check_ly_coincidence() {
     }
 }
 
-u16 Ppu::get_tile_data_address(u8 tile_index) {
-    if (is_bit(4, mmu.lcdc())) {
-        return 0x8000 + (tile_index * 16);
-    } else {
-        return 0x9000 + (static_cast<i8>(tile_index) * 16);
+// Tile numbers count from 0x8000, see TileCache
+void Ppu::update_lcdc() {
+    u8 lcdc = mmu.lcdc();
+
+    render.lcd_enabled      = is_bit(7, lcdc);
+    render.bg_enabled       = is_bit(0, lcdc);
+    render.sprites_enabled  = is_bit(1, lcdc);
+    render.window_enabled   = is_bit(5, lcdc);
+    render.signed_tile_data = !is_bit(4, lcdc);
+    render.sprite_height    = is_bit(2, lcdc) ? 16 : 8;
+    render.bg_map           = is_bit(3, lcdc) ? 1 : 0;
+    render.window_map       = is_bit(6, lcdc) ? 1 : 0;
+}
+
+void Ppu::update_palette(u8 reg) {
+    switch (reg) {
+        case 0x47:
+            decode_palette(mmu.bgp(), &render.colors[RenderState::BG_COLORS]);
+            break;
+        case 0x48:
+            decode_palette(mmu.obp0(), &render.colors[RenderState::OBP0_COLORS]);
+            break;
+        case 0x49:
+            decode_palette(mmu.obp1(), &render.colors[RenderState::OBP1_COLORS]);
+            break;
     }
 }
 
-u16 Ppu::get_tile_map() { return is_bit(3, mmu.lcdc()) ? 0x9C00 : 0x9800; }
+void Ppu::oam_scan() {
+    u64 on_line = sprite_index.on_line(mmu.ly(), render.sprite_height == 16);
 
-u16 Ppu::get_window_tile_map() { return is_bit(6, mmu.lcdc()) ? 0x9C00 : 0x9800; }
+    // The first 10 in OAM order make it onto the line
+    u64 selected = 0;
+    for (sprite_count = 0; on_line != 0 && sprite_count < MAX_SPRITES_PER_LINE; sprite_count++) {
+        selected |= on_line & -on_line;
+        on_line &= on_line - 1;
+    }
 
-void Ppu::oam_scan() {
-    sprite_buffer.fill(Sprite{});
-    int y_size   = sprite_size();
-    int scanline = mmu.ly();
-
-    sprite_count = 0;
-    for (int i = 0; i < 40 && sprite_count < MAX_SPRITES_PER_LINE; ++i) {
-        u16 sprite_addr = 0xFE00 + (i * 4);
-        u8  sprite_y    = (u8)(mmu.ppu_read_u8(sprite_addr) - 16);
-
-        if (scanline >= sprite_y && scanline < (sprite_y + y_size)) {
-            Sprite& s    = sprite_buffer[sprite_count++];
-            s.y          = sprite_y;
-            s.x          = mmu.ppu_read_u8(sprite_addr + 1);
-            s.tile_index = mmu.ppu_read_u8(sprite_addr + 2);
-            s.attributes = mmu.ppu_read_u8(sprite_addr + 3);
-            s.oam_index  = i;
-        }
+    // Copied in drawing priority order, which also fixes the mole issue on
+    // the acid test. OAM DMA can still change OAM before the line is drawn.
+    int n = 0;
+    for (u8 i : sprite_index.priority_order()) {
+        if (n == sprite_count) break;
+        if ((selected & (1ull << i)) == 0) continue;
+
+        const u8* entry = &mmu.ram.oam[i * 4];
+        Sprite&   s     = sprite_buffer[n++];
+        s.y             = entry[0] - 16;
+        s.x             = entry[1];
+        s.tile_index    = entry[2];
+        s.attributes    = entry[3];
+        s.oam_index     = i;
     }
 }
 
-void Ppu::decode_palette(u8 palette_data, Palette& palette) {
-    palette.colors[0] = default_colors[(palette_data >> 0) & 0x3];
-    palette.colors[1] = default_colors[(palette_data >> 2) & 0x3];
-    palette.colors[2] = default_colors[(palette_data >> 4) & 0x3];
-    palette.colors[3] = default_colors[(palette_data >> 6) & 0x3];
+void Ppu::decode_palette(u8 palette_data, Color* colors) {
+    for (int i = 0; i < 4; i++) {
+        DmgColor c = default_colors[(palette_data >> (i * 2)) & 0x3];
+        colors[i]  = {c.r, c.g, c.b, 255};
+    }
 }
 
-int Ppu::sprite_size() { return is_bit(2, mmu.lcdc()) ? 16 : 8; }
-
-bool Ppu::is_x_flipped(u8 attr) { return is_bit(5, attr); }
-
-bool Ppu::is_y_flipped(u8 attr) { return is_bit(6, attr); }
-
 bool Ppu::is_window() {
-    bool window_enable = is_bit(5, mmu.lcdc());
-    bool wy_cond       = mmu.wy() <= mmu.ly();
-    bool wx_cond       = mmu.wx() < (Ppu::SCREEN_WIDTH + 7);
+    bool wy_cond = mmu.wy() <= mmu.ly();
+    bool wx_cond = mmu.wx() < (Ppu::SCREEN_WIDTH + 7);
 
-    return window_enable && wy_cond && wx_cond;
+    return render.window_enabled && wy_cond && wx_cond;
 }
 
-bool Ppu::is_lcd_enabled() { return is_bit(7, mmu.lcdc()); }
-
 bool Ppu::is_bit(int bit, int val) { return (u8)((val >> bit) & 0x1) == 1; }
 
 u8 Ppu::set_bit(u8 bit, u8 val) { return val |= (u8)(1 << bit); }
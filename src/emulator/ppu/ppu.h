@@ -1,12 +1,26 @@
 #pragma once
 
 #include <array>
+#include <memory>
 
 #include "../mmu/mmu.h"
+#include "../scheduler.h"
+#include "line_record.h"
 #include "raylib.h"
+#include "render_worker.h"
+#include "scanline.h"
+#include "sprite_index.h"
+#include "tile_cache.h"
 
 struct PpuState;
 
+// How lines get drawn, picked when the emulator is created
+enum class Renderer {
+    Fast,      // Whole lines, drawn on a RenderWorker thread. Mode 3 takes an estimated time.
+    Accurate,  // Pixel FIFO run dot by dot through mode 3, see PixelFifo
+    Batched,   // Like Fast, but each frame is drawn at VBlank on a thread pool
+};
+
 enum class Mode {
     HBlank  = 0,
     VBlank  = 1,
@@ -14,27 +28,55 @@ enum class Mode {
     Drawing = 3,
 };
 
-struct Sprite {
-    u8 y;
-    u8 x;
-    u8 tile_index;
-    u8 attributes;
-    u8 oam_index;
-};
-
 struct DmgColor {
     u8 r, g, b;
 };
 
-struct Palette {
-    std::array<DmgColor, 4> colors;
+// A sprite pixel waiting to be mixed with the background, colour 0 is none
+struct ObjPixel {
+    u8   color;
+    bool obp1;
+    bool behind_bg;
+};
+
+// The accurate renderer's background fetcher and pixel FIFOs, part way
+// through mode 3. Nothing here is saved, a line that is being drawn when a
+// state is loaded starts over.
+struct PixelFifo {
+    enum class Step { Tile, DataLow, DataHigh, Push };
+
+    Step      step;
+    int       step_dots;  // Each step takes 2
+    int       fetch_x;    // Tiles fetched since the line or the window started
+    int       tile;       // Counts from 0x8000, like TileCache
+    int       tile_y;
+    const u8* fetched;  // Decoded row, once DataHigh is done
+    int       stall;    // Dots nothing happens for
+
+    std::array<u8, 8>       bg;  // Last 8 pixels are bg[8 - bg_size] onwards
+    int                     bg_size;
+    std::array<ObjPixel, 8> obj;  // obj[(obj_head + i) & 7] goes with the i-th next pixel
+    int                     obj_head;
+
+    int  dot;          // scanline_counter it has been run up to
+    int  x;            // Next pixel on the line
+    int  discard;      // Pixels thrown away before x moves: SCX & 7, or 7 - WX
+    int  next_sprite;  // Index into sprite_buffer
+    int  sprite_dots;  // Left of a sprite fetch, it's mixed in when this reaches 0
+    bool in_window;
+    bool window_y_reached;  // WY matched LY somewhere in this frame
 };
 
 class Ppu {
    public:
-    Mmu& mmu;
+    Mmu&        mmu;
+    Scheduler&  scheduler;
+    TileCache   tile_cache;  // For the accurate renderer, the worker has its own
+    SpriteIndex sprite_index;
 
-    Ppu(Mmu& m);
+    std::unique_ptr<RenderWorker> worker;  // Only with the fast and batched renderers
+
+    Ppu(Mmu& m, Scheduler& s, Renderer r = Renderer::Fast);
 
     static constexpr int SCREEN_WIDTH  = 160;
     static constexpr int SCREEN_HEIGHT = 144;
@@ -49,35 +91,56 @@ class Ppu {
     static constexpr int TOTAL_SCANLINES   = VISIBLE_SCANLINES + VBLANK_SCANLINES;
     static constexpr int CYCLES_PER_FRAME  = CYCLES_PER_SCANLINE * TOTAL_SCANLINES;
 
-    void tick(u8 cycles);
+    // Catches the PPU up to scheduler.now and schedules its next transition.
+    void sync();
+
+    // LCDC, STAT, SCX, LY and LYC decide when the next transition happens.
+    // Called before the CPU writes one: catches up to the start of the
+    // instruction and looks again once it has finished.
+    void sync_for_write();
+
+    // BGP, OBP0, OBP1, WY and WX only change what gets drawn. The fast
+    // renderer reads them once per line, the accurate one has to be caught
+    // up before the CPU writes one.
+    void sync_for_render();
 
     void save_state(PpuState& state) const;
     void load_state(const PpuState& state);
 
+    // Converts the lines drawn since the last call to RGBA first
     const std::array<Color, SCREEN_WIDTH * SCREEN_HEIGHT>& get_frame_buffer() const;
 
-    inline void update_palettes() {
-        decode_palette(mmu.bgp(), bg_palette);
-        decode_palette(mmu.obp0(), obj_palette0);
-        decode_palette(mmu.obp1(), obj_palette1);
-    }
+    // Called by the Mmu once it has written LCDC, or BGP/OBP0/OBP1
+    void update_lcdc();
+    void update_palette(u8 reg);
 
     Mode get_mode();
 
    private:
     static constexpr int MAX_SPRITES_PER_LINE = 10;
 
-    std::array<Color, SCREEN_WIDTH * SCREEN_HEIGHT> frame_buffer;
-    std::array<Sprite, MAX_SPRITES_PER_LINE>        sprite_buffer;
+    const ScanlineKernels& kernels;
+
+    Renderer renderer;
+    void (Ppu::*sync_fn)();  // sync_with<renderer>, Batched runs as Fast
+
+    // What the PPU draws: one palette entry per pixel, and the colours they
+    // stood for on each line. Only turned into RGBA when someone asks.
+    std::array<u8, SCREEN_WIDTH * SCREEN_HEIGHT>            index_frame;
+    std::array<std::array<Color, 16>, SCREEN_HEIGHT>        line_colors;  // Palettes, then white
+    mutable std::array<Color, SCREEN_WIDTH * SCREEN_HEIGHT> frame_buffer;
+    mutable bool                                            frame_buffer_stale;
+
+    std::array<Sprite, MAX_SPRITES_PER_LINE> sprite_buffer;
 
-    int     sprite_count;
-    Palette bg_palette;
-    Palette obj_palette0;
-    Palette obj_palette1;
-    int     scanline_counter;
-    int     window_line_counter;
-    bool    prev_signal;
-    int     mode_3_extra_cycles;
+    int         sprite_count;
+    RenderState render;
+    int         scanline_counter;
+    int         window_line_counter;
+    bool        prev_signal;
+    int         mode_3_extra_cycles;
+    u64         last_sync;
+    PixelFifo   fifo;
 
     static inline const std::array<DmgColor, 4> default_colors = {
         {{0xFF, 0xFF, 0xFF},  // White
@@ -90,13 +153,28 @@ class Ppu {
     //  Render
     // =============================================================
     void render_scanline();
-    void render_background_line();
-    void render_sprite_line();
-    void render_window_line();
+
+    // =============================================================
+    //  Pixel FIFO
+    // =============================================================
+    void start_fifo_line();
+    bool run_fifo();
+    void fifo_dot();
+    void fetch_step();
+    void shift_pixel();
+    void mix_sprite(const Sprite& s);
+    void finish_fifo_line();
+    bool window_starts();
 
     // =============================================================
     //  State Machine
     // =============================================================
+    template <Renderer R>
+    void sync_with();
+    template <Renderer R>
+    void tick(int cycles);
+    template <Renderer R>
+    void schedule_next_transition();
     void set_mode(Mode m);
     void update_stat_interrupt();
     void check_ly_coincidence();
@@ -104,20 +182,13 @@ class Ppu {
     // =============================================================
     //  Assets
     // =============================================================
-    u16  get_tile_data_address(u8 tile_index);
-    u16  get_tile_map();
-    u16  get_window_tile_map();
     void oam_scan();
-    void decode_palette(u8 palette_data, Palette& palette);
-    int  sprite_size();
+    void decode_palette(u8 palette_data, Color* colors);
 
     // =============================================================
     //  Helpers
     // =============================================================
-    bool        is_x_flipped(u8 attr);
-    bool        is_y_flipped(u8 attr);
     bool        is_window();
-    bool        is_lcd_enabled();
     static bool is_bit(int bit, int val);
     static u8   set_bit(u8 bit, u8 val);
     static u8   clear_bit(u8 bit, u8 val);
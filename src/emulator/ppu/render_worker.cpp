@@ -0,0 +1,275 @@
+#include "render_worker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+RenderWorker::RenderWorker(const u8* v, u8* frame, std::array<Color, 16>* colors, bool b)
+    : batched(b),
+      tile_cache(vram.data()),
+      map_cache(vram.data(), tile_cache),
+      kernels(scanline_kernels()),
+      index_frame(frame),
+      line_colors(colors) {
+    std::memcpy(vram.data(), v, vram.size());
+
+    int cores = std::thread::hardware_concurrency();
+    if (batched) {
+        pool = std::make_unique<ThreadPool>(std::max(cores - 1, 0));
+    }
+
+    threaded = !batched && cores > 1;
+    if (threaded) {
+        thread = std::thread(&RenderWorker::run, this);
+    }
+}
+
+RenderWorker::~RenderWorker() {
+    if (!threaded) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_one();
+    thread.join();
+}
+
+LineRecord& RenderWorker::next_line() {
+    // Batched, a frame fits: this only draws early when the LCD went off
+    // before VBlank
+    while (lines.full()) {
+        make_room();
+    }
+    return lines.back();
+}
+
+void RenderWorker::submit_line() {
+    lines.back().vram_writes = vram_log.pushed();
+    lines.push();
+
+    if (batched) {
+        return;
+    }
+
+    if (!threaded) {
+        const LineRecord& r = lines.front();
+        apply_vram_writes(r.vram_writes);
+        draw(r);
+        lines.pop();
+        return;
+    }
+
+    // Pairs with the fence in run(): either the worker sees the line, or
+    // this sees that it went to sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        work_ready.notify_one();
+    }
+}
+
+void RenderWorker::wait() {
+    ZoneScoped;
+
+    while (!lines.empty()) {
+        make_room();
+    }
+}
+
+void RenderWorker::reset_vram(const u8* v) {
+    while (!lines.empty() || !vram_log.empty()) {
+        make_room();
+    }
+
+    // The worker has nothing to do, so it doesn't touch any of this
+    std::memcpy(vram.data(), v, vram.size());
+    tile_cache.invalidate_all();
+    map_cache.invalidate_all();
+}
+
+void RenderWorker::wake_and_yield() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        work_ready.notify_one();
+    }
+    std::this_thread::yield();
+}
+
+// The emulation thread filled a ring and has to wait for the worker, or do
+// its work when there is no worker
+void RenderWorker::make_room() {
+    if (threaded) {
+        wake_and_yield();
+    } else if (batched) {
+        draw_batch();
+    } else {
+        apply_vram_writes(vram_log.pushed());
+    }
+}
+
+bool RenderWorker::has_work() const { return !lines.empty() || !vram_log.empty(); }
+
+void RenderWorker::run() {
+    // How many times to look for work before going to sleep. Lines come a
+    // few microseconds apart while the emulator runs, too close to sleep in
+    // between every one of them.
+    static constexpr int SPINS = 1 << 14;
+
+    while (true) {
+        // Read before looking at `lines`: a line pushed after this can only
+        // come after these writes
+        u64 writes = vram_log.pushed();
+
+        if (!lines.empty()) {
+            const LineRecord& r = lines.front();
+            apply_vram_writes(r.vram_writes);
+            draw(r);
+            lines.pop();
+            continue;
+        }
+
+        if (vram_log.popped() != writes) {
+            apply_vram_writes(writes);
+            continue;
+        }
+
+        int spins = 0;
+        while (!has_work() && spins < SPINS && !stopping.load(std::memory_order_relaxed)) {
+            spins++;
+        }
+
+        if (spins == SPINS) {
+            std::unique_lock<std::mutex> lock(mutex);
+            sleeping = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            work_ready.wait(lock, [this] { return stopping || has_work(); });
+            sleeping = false;
+        }
+
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void RenderWorker::apply_vram_writes(u64 end) {
+    while (vram_log.popped() < end) {
+        VramWrite w = vram_log.front();
+        vram_log.pop();
+
+        vram[w.addr - 0x8000] = w.val;
+        if (w.addr < 0x9800) {
+            tile_cache.invalidate(w.addr);
+            map_cache.invalidate_tile(w.addr);
+        } else {
+            map_cache.invalidate_map(w.addr);
+        }
+    }
+}
+
+void RenderWorker::draw_batch() {
+    ZoneScoped;
+
+    while (!lines.empty()) {
+        // The lines up to the next VRAM write, that each have a row of the
+        // frame to themselves
+        const LineRecord& first = lines.front();
+        u64               count = lines.pushed() - lines.popped();
+        u64               n     = 1;
+        while (n < count && lines.peek(n).vram_writes == first.vram_writes && lines.peek(n).y > lines.peek(n - 1).y) {
+            n++;
+        }
+
+        apply_vram_writes(first.vram_writes);
+
+        // Bring the caches up to date first, drawing only reads them
+        for (u64 i = 0; i < n; i++) {
+            const LineRecord& r = lines.peek(i);
+            if (r.state.bg_enabled) {
+                map_cache.line(r.state.bg_map, r.state.signed_tile_data, static_cast<u8>(r.y + r.scy));
+            }
+            if (r.window_line != LineRecord::NO_WINDOW) {
+                map_cache.line(r.state.window_map, r.state.signed_tile_data, r.window_line);
+            }
+        }
+        tile_cache.clean_all();
+
+        pool->run(static_cast<int>(n), [this](int i) { draw(lines.peek(i)); });
+
+        for (u64 i = 0; i < n; i++) {
+            lines.pop();
+        }
+    }
+
+    apply_vram_writes(vram_log.pushed());
+}
+
+void RenderWorker::draw(const LineRecord& r) {
+    ZoneScoped;
+
+    Line line;
+    line.fill(RenderState::BLANK_COLORS);
+
+    draw_background(r, line);
+    draw_window(r, line);
+    draw_sprites(r, line);
+
+    line_colors[r.y] = r.state.colors;
+    std::memcpy(&index_frame[r.y * SCREEN_WIDTH], &line[LINE_START], SCREEN_WIDTH);
+}
+
+void RenderWorker::draw_background(const LineRecord& r, Line& line) {
+    if (!r.state.bg_enabled) {
+        std::memset(&line[LINE_START], RenderState::BLANK_COLORS, SCREEN_WIDTH);
+        return;
+    }
+
+    u8        bg_y = r.y + r.scy;
+    const u8* src  = map_cache.line(r.state.bg_map, r.state.signed_tile_data, bg_y);
+
+    // The map wraps around horizontally past SCX = 96
+    int first = std::min(MapCache::SIZE - r.scx, SCREEN_WIDTH);
+    std::memcpy(&line[LINE_START], src + r.scx, first);
+    std::memcpy(&line[LINE_START + first], src, SCREEN_WIDTH - first);
+}
+
+void RenderWorker::draw_window(const LineRecord& r, Line& line) {
+    if (r.window_line == LineRecord::NO_WINDOW) {
+        return;
+    }
+
+    const u8* src = map_cache.line(r.state.window_map, r.state.signed_tile_data, r.window_line);
+
+    // Don't need offscreen pixels
+    int x        = std::max(r.window_x, 0);
+    int window_x = x - r.window_x;
+
+    std::memcpy(&line[LINE_START + x], src + window_x, SCREEN_WIDTH - x);
+}
+
+void RenderWorker::draw_sprites(const LineRecord& r, Line& line) {
+    if (!r.state.sprites_enabled) {
+        return;
+    }
+
+    // Sprites with BG priority only show over BG colour index 0, or where
+    // the BG is off, whatever colours the palette gives them
+    alignas(16) static constexpr u8 hidden[16] = {0x00, 0xFF, 0xFF, 0xFF};
+    Line                            bg_line    = line;
+
+    for (int i = r.sprite_count - 1; i >= 0; --i) {
+        const Sprite& s = r.sprites[i];
+
+        if (s.x == 0 || s.x >= 168) {
+            continue;
+        }
+
+        const u8* row     = sprite_row(tile_cache, s, r.y, r.state.sprite_height);
+        u8        palette = (s.attributes & 0x10) ? RenderState::OBP1_COLORS : RenderState::OBP0_COLORS;
+        int       offset  = LINE_START + s.x - 8;
+
+        kernels.draw_sprite(&line[offset], row, palette, &bg_line[offset], (s.attributes & 0x80) ? hidden : nullptr);
+    }
+}
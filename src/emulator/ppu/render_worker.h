@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "line_record.h"
+#include "map_cache.h"
+#include "scanline.h"
+#include "spsc_ring.h"
+#include "thread_pool.h"
+#include "tile_cache.h"
+
+// Draws the fast renderer's lines on a thread of its own, so the emulation
+// thread only has to describe each line at the end of mode 3.
+//
+// The worker keeps its own copy of VRAM, with its own tile and map caches.
+// The Mmu logs every VRAM write, and each line says how much of the log came
+// before it, so a line is drawn from VRAM exactly as it was when mode 3
+// ended. Sprites are already copied out of OAM in the line record.
+//
+// With a single core there is no thread, lines are drawn as they come in.
+//
+// Batched, there is no worker thread either: the lines of a frame pile up
+// until VBlank, then the emulation thread and a pool of helpers draw them
+// all at once. Lines that saw the same VRAM are drawn together, each from
+// its own buffers, so the frame comes out the same as drawn one line at a
+// time. For headless runs, where nothing waits on the frame before VBlank.
+class RenderWorker {
+   public:
+    static constexpr int SCREEN_WIDTH  = 160;
+    static constexpr int SCREEN_HEIGHT = 144;
+
+    // Draws into `index_frame` and `line_colors`, which nothing else may
+    // touch unless wait() has just returned
+    RenderWorker(const u8* vram, u8* index_frame, std::array<Color, 16>* line_colors, bool batched = false);
+    ~RenderWorker();
+
+    RenderWorker(const RenderWorker&)            = delete;
+    RenderWorker& operator=(const RenderWorker&) = delete;
+
+    // =============================================================
+    //  Emulation Thread
+    // =============================================================
+    inline void write_vram(u16 addr, u8 val) {
+        while (vram_log.full()) {
+            make_room();
+        }
+        vram_log.back() = {addr, val};
+        vram_log.push();
+    }
+
+    // Fill in the record next_line() returns, then submit_line() it
+    LineRecord& next_line();
+    void        submit_line();
+
+    // Until every submitted line is drawn
+    void wait();
+
+    // VBlank, when a batched frame gets drawn
+    inline void end_frame() {
+        if (batched) draw_batch();
+    }
+
+    // VRAM changed behind the log's back, after a state load
+    void reset_vram(const u8* vram);
+
+   private:
+    struct VramWrite {
+        u16 addr;
+        u8  val;
+    };
+
+    // Lines in flight, a whole frame when batched
+    SpscRing<LineRecord, 256>     lines;
+    SpscRing<VramWrite, 1u << 14> vram_log;
+
+    bool                        batched;
+    std::unique_ptr<ThreadPool> pool;  // Batched only
+
+    bool                    threaded;
+    std::thread             thread;
+    std::mutex              mutex;
+    std::condition_variable work_ready;
+    std::atomic<bool>       sleeping{false};
+    std::atomic<bool>       stopping{false};
+
+    // =============================================================
+    //  Worker Thread
+    // =============================================================
+    std::array<u8, 0x2000> vram{};
+    TileCache              tile_cache;
+    MapCache               map_cache;
+    const ScanlineKernels& kernels;
+
+    u8*                    index_frame;
+    std::array<Color, 16>* line_colors;
+
+    // Sprites can hang up to 8 pixels off either edge of a line
+    static constexpr int LINE_START = 8;
+
+    using Line = std::array<u8, LINE_START + SCREEN_WIDTH + 8>;
+
+    void wake_and_yield();
+    void make_room();
+    void run();
+    bool has_work() const;
+    void apply_vram_writes(u64 end);
+    void draw_batch();
+
+    // Only write the line's own row of the frame. With clean caches, lines
+    // from the same VRAM can be drawn at once.
+    void draw(const LineRecord& r);
+    void draw_background(const LineRecord& r, Line& line);
+    void draw_window(const LineRecord& r, Line& line);
+    void draw_sprites(const LineRecord& r, Line& line);
+};
@@ -0,0 +1,184 @@
+#include "scanline.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SCANLINE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only let a function use instructions it was compiled for,
+// MSVC lets any function use any intrinsic.
+#if defined(SCANLINE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace {
+
+// =============================================================
+//  Scalar
+// =============================================================
+void to_rgba_scalar(const u8* line, const Color* colors, Color* out, int count) {
+    for (int i = 0; i < count; i++) {
+        out[i] = colors[line[i]];
+    }
+}
+
+void draw_sprite_scalar(u8* line, const u8* row, u8 palette, const u8* under, const u8* hidden) {
+    for (int i = 0; i < 8; i++) {
+        if (row[i] == 0) continue;
+        if (hidden && hidden[under[i]]) continue;
+        line[i] = palette + row[i];
+    }
+}
+
+constexpr ScanlineKernels scalar_kernels = {"scalar", to_rgba_scalar, draw_sprite_scalar};
+
+#ifdef SCANLINE_X86
+// Splits the colour table into one 16-byte table per channel, for PSHUFB
+struct ChannelTables {
+    alignas(16) u8 r[16];
+    alignas(16) u8 g[16];
+    alignas(16) u8 b[16];
+    alignas(16) u8 a[16];
+
+    ChannelTables(const Color* colors) {
+        for (int i = 0; i < 16; i++) {
+            r[i] = colors[i].r;
+            g[i] = colors[i].g;
+            b[i] = colors[i].b;
+            a[i] = colors[i].a;
+        }
+    }
+};
+
+// =============================================================
+//  SSE4.1
+// =============================================================
+TARGET_SSE41 void to_rgba_sse41(const u8* line, const Color* colors, Color* out, int count) {
+    ChannelTables tables(colors);
+    __m128i       r_table = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.r));
+    __m128i       g_table = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.g));
+    __m128i       b_table = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.b));
+    __m128i       a_table = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.a));
+
+    for (int i = 0; i < count; i += 16) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + i));
+        __m128i r     = _mm_shuffle_epi8(r_table, index);
+        __m128i g     = _mm_shuffle_epi8(g_table, index);
+        __m128i b     = _mm_shuffle_epi8(b_table, index);
+        __m128i a     = _mm_shuffle_epi8(a_table, index);
+
+        // Interleave the channels back into RGBA pixels
+        __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+        __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+        __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+        __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+
+        __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+        _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+    }
+}
+
+TARGET_SSE41 void draw_sprite_sse41(u8* line, const u8* row, u8 palette, const u8* under, const u8* hidden) {
+    __m128i pixels = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row));
+    __m128i dst    = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(line));
+    __m128i opaque = _mm_xor_si128(_mm_cmpeq_epi8(pixels, _mm_setzero_si128()), _mm_set1_epi8(-1));
+
+    if (hidden) {
+        __m128i below = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(under));
+        __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hidden));
+        opaque        = _mm_andnot_si128(_mm_shuffle_epi8(table, below), opaque);
+    }
+
+    __m128i colored = _mm_add_epi8(pixels, _mm_set1_epi8(palette));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(line), _mm_blendv_epi8(dst, colored, opaque));
+}
+
+constexpr ScanlineKernels sse41_kernels = {"SSE4.1", to_rgba_sse41, draw_sprite_sse41};
+
+// =============================================================
+//  AVX2
+// =============================================================
+TARGET_AVX2 void to_rgba_avx2(const u8* line, const Color* colors, Color* out, int count) {
+    ChannelTables tables(colors);
+    __m256i r_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tables.r)));
+    __m256i g_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tables.g)));
+    __m256i b_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tables.b)));
+    __m256i a_table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tables.a)));
+
+    for (int i = 0; i < count; i += 32) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line + i));
+        __m256i r     = _mm256_shuffle_epi8(r_table, index);
+        __m256i g     = _mm256_shuffle_epi8(g_table, index);
+        __m256i b     = _mm256_shuffle_epi8(b_table, index);
+        __m256i a     = _mm256_shuffle_epi8(a_table, index);
+
+        // Unpacking works within each 128-bit half, so the first half holds
+        // pixels 0-15 and the second 16-31, four at a time
+        __m256i rg_lo = _mm256_unpacklo_epi8(r, g);
+        __m256i rg_hi = _mm256_unpackhi_epi8(r, g);
+        __m256i ba_lo = _mm256_unpacklo_epi8(b, a);
+        __m256i ba_hi = _mm256_unpackhi_epi8(b, a);
+
+        __m256i p0 = _mm256_unpacklo_epi16(rg_lo, ba_lo);  // 0-3   | 16-19
+        __m256i p1 = _mm256_unpackhi_epi16(rg_lo, ba_lo);  // 4-7   | 20-23
+        __m256i p2 = _mm256_unpacklo_epi16(rg_hi, ba_hi);  // 8-11  | 24-27
+        __m256i p3 = _mm256_unpackhi_epi16(rg_hi, ba_hi);  // 12-15 | 28-31
+
+        __m256i* dst = reinterpret_cast<__m256i*>(out + i);
+        _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(p0, p1, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(p2, p3, 0x20));
+        _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(p0, p1, 0x31));
+        _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+    }
+}
+
+// A sprite row is 8 pixels, the SSE4.1 version already does it in one go
+constexpr ScanlineKernels avx2_kernels = {"AVX2", to_rgba_avx2, draw_sprite_sse41};
+
+bool has_sse41() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+bool has_avx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+const ScanlineKernels& select_kernels() {
+#ifdef SCANLINE_X86
+    if (has_avx2()) return avx2_kernels;
+    if (has_sse41()) return sse41_kernels;
+#endif
+    return scalar_kernels;
+}
+
+}  // namespace
+
+const ScanlineKernels& scanline_kernels() {
+    static const ScanlineKernels& kernels = select_kernels();
+    return kernels;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "raylib.h"
+
+// The per-pixel steps of drawing a scanline, in a scalar version and vector
+// versions for x86. scanline_kernels() picks the best one the host CPU
+// supports, once.
+//
+// A line is built as one byte per pixel, an index into a 16-entry colour
+// table (see RenderState), and only turned into colours at the end.
+//
+// Background and window have no kernel: their pixels are already bytes in
+// MapCache's bitmaps, so SCX is the offset a line is copied from and the
+// window is a second copy from WX on. memcpy is as fast as that gets.
+struct ScanlineKernels {
+    const char* name;
+
+    // out[i] = colors[line[i]]. `count` is a multiple of 32.
+    void (*to_rgba)(const u8* line, const Color* colors, Color* out, int count);
+
+    // Draws the 8 pixels of a sprite row over line[0-7]. row[i] is a colour
+    // index, 0 being transparent, and ends up as `palette + row[i]`. If
+    // `hidden` isn't nullptr the sprite goes behind pixels where
+    // hidden[under[i]] is 0xFF.
+    void (*draw_sprite)(u8* line, const u8* row, u8 palette, const u8* under, const u8* hidden);
+};
+
+const ScanlineKernels& scanline_kernels();
@@ -0,0 +1,67 @@
+#include "sprite_index.h"
+
+#include <algorithm>
+
+SpriteIndex::SpriteIndex(const u8* o) : oam(o) { rebuild(); }
+
+const std::array<u8, SpriteIndex::SPRITE_COUNT>& SpriteIndex::priority_order() {
+    if (order_stale) {
+        std::stable_sort(order.begin(), order.end(), [this](u8 a, u8 b) {
+            if (indexed_x[a] != indexed_x[b]) {
+                return indexed_x[a] < indexed_x[b];
+            }
+            return a < b;
+        });
+        order_stale = false;
+    }
+    return order;
+}
+
+void SpriteIndex::update(u8 first, u8 end) {
+    for (int sprite = first / 4; sprite * 4 < end; sprite++) {
+        u8 y = oam[sprite * 4];
+        u8 x = oam[sprite * 4 + 1];
+
+        if (y != indexed_y[sprite]) {
+            set_lines(sprite, indexed_y[sprite], false);
+            set_lines(sprite, y, true);
+            indexed_y[sprite] = y;
+        }
+
+        if (x != indexed_x[sprite]) {
+            indexed_x[sprite] = x;
+            order_stale       = true;
+        }
+    }
+}
+
+void SpriteIndex::rebuild() {
+    short_lines.fill(0);
+    tall_lines.fill(0);
+
+    for (int sprite = 0; sprite < SPRITE_COUNT; sprite++) {
+        indexed_y[sprite] = oam[sprite * 4];
+        indexed_x[sprite] = oam[sprite * 4 + 1];
+        set_lines(sprite, indexed_y[sprite], true);
+        order[sprite] = sprite;
+    }
+    order_stale = true;
+}
+
+// A sprite at OAM Y covers lines Y - 16 up to Y - 8 or Y, it doesn't wrap
+// around to the top of the screen
+void SpriteIndex::set_lines(int sprite, u8 y, bool present) {
+    u64 bit   = 1ull << sprite;
+    int top   = y - 16;
+    int start = std::max(top, 0);
+
+    for (int line = start; line < std::min(top + 16, LINES); line++) {
+        if (present) {
+            tall_lines[line] |= bit;
+            if (line < top + 8) short_lines[line] |= bit;
+        } else {
+            tall_lines[line] &= ~bit;
+            short_lines[line] &= ~bit;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+
+// Which sprites are on each visible line, kept up to date as OAM changes
+// instead of scanning all 40 entries on every line. The Mmu reports every
+// OAM byte the CPU or OAM DMA writes, only Y and X matter here.
+class SpriteIndex {
+   public:
+    static constexpr int SPRITE_COUNT = 40;
+    static constexpr int LINES        = 144;
+
+    SpriteIndex(const u8* oam);
+
+    // One bit per OAM entry, for 8x8 or 8x16 sprites
+    inline u64 on_line(int line, bool tall) const { return tall ? tall_lines[line] : short_lines[line]; }
+
+    // OAM entries from highest to lowest drawing priority: lowest X first,
+    // then lowest OAM index
+    const std::array<u8, SPRITE_COUNT>& priority_order();
+
+    // OAM bytes [first, end) changed
+    void update(u8 first, u8 end);
+
+    // All of OAM may have changed
+    void rebuild();
+
+   private:
+    const u8* oam;
+
+    std::array<u64, LINES> short_lines;
+    std::array<u64, LINES> tall_lines;
+
+    // OAM Y and X as last indexed
+    std::array<u8, SPRITE_COUNT> indexed_y;
+    std::array<u8, SPRITE_COUNT> indexed_x;
+
+    std::array<u8, SPRITE_COUNT> order;
+    bool                         order_stale;
+
+    void set_lines(int sprite, u8 y, bool present);
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Fixed size queue between one producer thread and one consumer thread,
+// without locks. Entries are written in place: the producer fills back()
+// and publishes it with push(), the consumer reads front() and frees the
+// slot with pop(). The counts only go up, so they also work as positions
+// in the stream of entries. N has to be a power of two.
+template <typename T, size_t N>
+class SpscRing {
+    static_assert((N & (N - 1)) == 0, "SpscRing size has to be a power of two");
+
+   public:
+    // Producer
+    inline bool full() const {
+        return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == N;
+    }
+    inline T&   back() { return slots[tail.load(std::memory_order_relaxed) & (N - 1)]; }
+    inline void push() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Consumer. peek(i) is the entry i places behind front()
+    inline const T& front() const { return slots[head.load(std::memory_order_relaxed) & (N - 1)]; }
+    inline const T& peek(u64 i) const { return slots[(head.load(std::memory_order_relaxed) + i) & (N - 1)]; }
+    inline void     pop() { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Either side
+    inline bool empty() const { return popped() == pushed(); }
+    inline u64  pushed() const { return tail.load(std::memory_order_acquire); }
+    inline u64  popped() const { return head.load(std::memory_order_acquire); }
+
+   private:
+    // Apart, so the two threads don't keep taking the cache line off each other
+    alignas(64) std::atomic<u64> head{0};
+    alignas(64) std::atomic<u64> tail{0};
+    std::array<T, N>             slots;
+};
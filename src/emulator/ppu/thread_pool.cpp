@@ -0,0 +1,70 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(int helpers) {
+    for (int i = 0; i < helpers; i++) {
+        threads.emplace_back(&ThreadPool::help, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+void ThreadPool::run(int count, const std::function<void(int)>& fn) {
+    if (threads.empty() || count <= 1) {
+        for (int i = 0; i < count; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job       = &fn;
+        job_count = count;
+        busy      = static_cast<int>(threads.size());
+        next      = 0;
+        generation++;
+    }
+    started.notify_all();
+
+    work();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::help() {
+    u64 seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        work();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::work() {
+    for (int i = next.fetch_add(1); i < job_count; i = next.fetch_add(1)) {
+        (*job)(i);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads that help whoever calls run() get through the iterations of a
+// loop. They sleep between loops.
+class ThreadPool {
+   public:
+    explicit ThreadPool(int helpers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Calls fn(i) for every i in [0, count), in no particular order or
+    // thread, and returns once they have all finished
+    void run(int count, const std::function<void(int)>& fn);
+
+   private:
+    std::vector<std::thread> threads;
+    std::mutex               mutex;
+    std::condition_variable  started;
+    std::condition_variable  finished;
+
+    // The loop being run, set under `mutex`
+    const std::function<void(int)>* job = nullptr;
+    int                             job_count;
+    u64                             generation = 0;
+    int                             busy       = 0;  // Helpers still on it
+    bool                            stopping   = false;
+
+    std::atomic<int> next{0};  // Next iteration to hand out
+
+    void help();
+    void work();
+};
@@ -0,0 +1,30 @@
+#include "tile_cache.h"
+
+TileCache::TileCache(const u8* v) : vram(v) { invalidate_all(); }
+
+void TileCache::clean_all() {
+    for (int tile = 0; tile < TILE_COUNT; tile++) {
+        make_clean(tile);
+    }
+}
+
+void TileCache::decode(int tile) {
+    const u8* data        = vram + tile * 16;
+    u8*       out         = &decoded[tile * 64];
+    u8*       out_flipped = &flipped[tile * 64];
+
+    for (int y = 0; y < 8; y++) {
+        u8 byte1 = data[y * 2];
+        u8 byte2 = data[y * 2 + 1];
+
+        for (int x = 0; x < 8; x++) {
+            int color_bit = 7 - x;
+            u8  color_id  = (((byte2 >> color_bit) & 1) << 1) | ((byte1 >> color_bit) & 1);
+
+            out[y * 8 + x]               = color_id;
+            out_flipped[y * 8 + (7 - x)] = color_id;
+        }
+    }
+
+    dirty[tile >> 6] &= ~(1ull << (tile & 63));
+}
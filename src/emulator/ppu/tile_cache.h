@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+
+// Every tile in VRAM decoded to one colour index (0-3) per byte, so the
+// renderer reads 8 pixels of a tile row at once instead of pulling bits out
+// of the two bit planes for every pixel. A second copy is mirrored
+// horizontally for X-flipped sprites.
+//
+// Tiles are decoded lazily: the Mmu marks them dirty when the CPU writes
+// 0x8000 - 0x97FF, the next row() of the tile decodes it again.
+class TileCache {
+   public:
+    static constexpr int TILE_COUNT = 384;
+
+    TileCache(const u8* vram);
+
+    // Row `y` of `tile`. 0-15 for 8x16 sprites, rows 8-15 belong to the
+    // next tile. `tile` counts from 0x8000, 16 bytes each.
+    inline const u8* row(int tile, int y) {
+        int line = tile * 8 + y;
+        make_clean(line >> 3);
+        return &decoded[line * 8];
+    }
+
+    inline const u8* flipped_row(int tile, int y) {
+        int line = tile * 8 + y;
+        make_clean(line >> 3);
+        return &flipped[line * 8];
+    }
+
+    inline void invalidate(u16 addr) {
+        int tile = (addr - 0x8000) >> 4;
+        dirty[tile >> 6] |= 1ull << (tile & 63);
+    }
+
+    void invalidate_all() { dirty.fill(~0ull); }
+
+    // Decodes every dirty tile, so row() and flipped_row() only read until
+    // the next invalidate() and can be called from several threads
+    void clean_all();
+
+   private:
+    const u8* vram;
+
+    std::array<u64, TILE_COUNT / 64> dirty;
+    std::array<u8, TILE_COUNT * 64>  decoded;
+    std::array<u8, TILE_COUNT * 64>  flipped;
+
+    inline void make_clean(int tile) {
+        if (dirty[tile >> 6] & (1ull << (tile & 63))) {
+            decode(tile);
+        }
+    }
+
+    void decode(int tile);
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <limits>
+
+// Things that happen at a known cycle. Each kind has a single slot, so
+// scheduling an event again just moves it.
+enum class Event : u8 {
+    Timer,     // TIMA overflow
+    Ppu,       // Next PPU mode transition, or a catch-up after a register write
+    Dma,       // OAM DMA completion
+    FrameEnd,  // End of the current run_frame
+    Count,
+};
+
+// Keeps the cycle of every pending event so run_frame can let the CPU run
+// until the earliest one, instead of ticking every component after every
+// instruction.
+class Scheduler {
+   public:
+    static constexpr u64 NEVER = std::numeric_limits<u64>::max();
+
+    // Cycles since power on. While the CPU is executing an instruction this
+    // is the cycle the instruction started on.
+    u64 now = 0;
+
+    Scheduler() { times.fill(NEVER); }
+
+    inline void schedule(Event e, u64 cycle) {
+        times[static_cast<u8>(e)] = cycle;
+        update_next();
+    }
+
+    inline void cancel(Event e) { schedule(e, NEVER); }
+
+    inline bool is_due(Event e) const { return times[static_cast<u8>(e)] <= now; }
+
+    inline u64 next_event() const { return next; }
+
+   private:
+    std::array<u64, static_cast<u8>(Event::Count)> times;
+    u64                                             next = NEVER;
+
+    inline void update_next() {
+        next = NEVER;
+        for (u64 t : times) {
+            if (t < next) next = t;
+        }
+    }
+};
@@ -10,11 +10,21 @@
 
 int main(int argc, char** argv) {
     std::string rom_path;
+    Renderer    renderer = Renderer::Fast;
     Screen      screen;
 
-    if (argc > 1) {
-        rom_path = argv[1];
-    } else {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--accurate-ppu") {
+            renderer = Renderer::Accurate;
+        } else if (arg == "--batch-ppu") {
+            renderer = Renderer::Batched;
+        } else {
+            rom_path = arg;
+        }
+    }
+
+    if (rom_path.empty()) {
         rom_path = screen.drag_and_drop_wait();
     }
 
@@ -27,7 +37,7 @@ int main(int argc, char** argv) {
     pak.rom_info();
     pak.checksum();
 
-    Emulator emulator(pak);
+    Emulator emulator(pak, renderer);
     screen.connect_ppu(emulator.ppu);
 
     while (!screen.should_close()) {
@@ -45,6 +55,8 @@ int main(int argc, char** argv) {
             emulator.joy.action_performed();
         }
 
+        // Capped, raylib sleeps out the rest of each frame, so time saved by
+        // skipping idle loops goes back to the host without any help here
         if (emulator.joy.is_fps_uncapped()) {
             SetTargetFPS(0);
         } else {
@@ -54,6 +66,8 @@ int main(int argc, char** argv) {
         emulator.run_frame();
         screen.update(emulator.joy.should_display_fps());
 
+        TracyPlot("Idle loops skipped", static_cast<int64_t>(emulator.idle_loops_skipped));
+
         FrameMark;
     }
 
@@ -0,0 +1,578 @@
+// Checks the parts of the core that work something out differently from the
+// plain version of the code against that plain version. Each section says
+// what it compares with.
+//
+// xmake build core_tests && xmake run core_tests
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "emulator/emulator.h"
+#include "emulator/pak/pak.h"
+
+namespace {
+
+int checks   = 0;
+int failures = 0;
+
+// Stops printing after a few, a broken op fails for most of its inputs
+void check(bool ok, const std::string& what) {
+    checks++;
+    if (ok) return;
+
+    if (failures++ < 20) {
+        std::cerr << "FAIL: " << what << std::endl;
+    }
+}
+
+std::string hex(int value) {
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "%02X", value);
+    return buf;
+}
+
+// =============================================================
+//  Test ROMs
+// =============================================================
+
+// A ROM of `banks` 16K banks where the first byte of each bank is its number
+std::string make_rom(const std::string& name, u8 type, int banks) {
+    std::vector<char> data(banks * 0x4000, 0);
+    for (int bank = 0; bank < banks; bank++) {
+        data[bank * 0x4000] = static_cast<char>(bank);
+    }
+
+    data[0x147] = static_cast<char>(type);
+    for (int code = 0; (2 << code) < banks; code++) {
+        data[0x148] = static_cast<char>(code + 1);
+    }
+
+    std::string   path = (std::filesystem::temp_directory_path() / ("bboy2_" + name + ".gb")).string();
+    std::ofstream out(path, std::ios::binary);
+    out.write(data.data(), data.size());
+    return path;
+}
+
+// An emulator with nothing to do, to run single instructions on
+struct Machine {
+    std::unique_ptr<Pak>      pak;
+    std::unique_ptr<Emulator> emu;
+
+    Machine(const std::string& rom) {
+        // Pak prints the header
+        std::streambuf* old = std::cout.rdbuf(nullptr);
+        pak                 = std::make_unique<Pak>(rom);
+        emu                 = std::make_unique<Emulator>(*pak);
+        std::cout.rdbuf(old);
+
+        emu->mmu.write_u8(0xFFFF, 0x00);  // No interrupts
+        emu->cpu.IME = false;
+    }
+
+    // Writes `code` to WRAM and runs `steps` instructions of it
+    void run(std::initializer_list<u8> code, int steps) {
+        u16 addr = PROGRAM;
+        for (u8 byte : code) {
+            emu->mmu.write_u8(addr++, byte);
+        }
+
+        emu->cpu.reg.PC = PROGRAM;
+        for (int i = 0; i < steps; i++) {
+            emu->cpu.step();
+        }
+    }
+
+    static constexpr u16 PROGRAM = 0xC000;
+    static constexpr u16 STACK   = 0xD000;
+};
+
+// =============================================================
+//  Flags
+// =============================================================
+
+// The flag formulas the CPU used before flags were lazy, worked out eagerly
+struct Eager {
+    u8   a;
+    bool z, n, h, c;
+
+    u8 f() const { return (z << 7) | (n << 6) | (h << 5) | (c << 4); }
+};
+
+Eager eager_alu(int op, u8 a, u8 b, bool carry) {
+    Eager r{a, false, false, false, false};
+    int   res;
+
+    switch (op) {
+        case 0:  // ADD
+            res = a + b;
+            r   = {u8(res), (res & 0xFF) == 0, false, (a & 0x0F) + (b & 0x0F) > 0x0F, res > 0xFF};
+            break;
+        case 1:  // ADC
+            res = a + b + carry;
+            r   = {u8(res), (res & 0xFF) == 0, false, (a & 0x0F) + (b & 0x0F) + carry > 0x0F, res > 0xFF};
+            break;
+        case 2:  // SUB
+            res = a - b;
+            r   = {u8(res), (res & 0xFF) == 0, true, (a & 0x0F) < (b & 0x0F), a < b};
+            break;
+        case 3:  // SBC
+            res = a - b - carry;
+            r   = {u8(res), (res & 0xFF) == 0, true, (a & 0x0F) < (b & 0x0F) + carry, a < b + carry};
+            break;
+        case 4:  // AND
+            r = {u8(a & b), (a & b) == 0, false, true, false};
+            break;
+        case 5:  // XOR
+            r = {u8(a ^ b), (a ^ b) == 0, false, false, false};
+            break;
+        case 6:  // OR
+            r = {u8(a | b), (a | b) == 0, false, false, false};
+            break;
+        case 7:  // CP
+            r = {a, a == b, true, (a & 0x0F) < (b & 0x0F), a < b};
+            break;
+    }
+    return r;
+}
+
+Eager eager_daa(u8 a, bool n, bool h, bool c) {
+    if (n) {
+        if (c) a -= 0x60;
+        if (h) a -= 0x06;
+    } else {
+        if (c || a > 0x99) {
+            a += 0x60;
+            c = true;
+        }
+        if (h || (a & 0x0F) > 0x09) a += 0x06;
+    }
+    return {a, a == 0, n, false, c};
+}
+
+const char* const ALU_NAMES[8] = {"ADD", "ADC", "SUB", "SBC", "AND", "XOR", "OR", "CP"};
+
+// Every ALU op on every A, B and carry in, the carry coming either from F or
+// from a lazily evaluated shift (RL D). Flags are read both through flags()
+// and through PUSH AF, which is what software sees.
+void test_alu_flags(Machine& m) {
+    Registers& reg = m.emu->cpu.reg;
+
+    for (int op = 0; op < 8; op++) {
+        u8 opcode = 0x80 | (op << 3);  // op A, B
+
+        for (int lazy_carry = 0; lazy_carry < 2; lazy_carry++) {
+            for (int carry = 0; carry < 2; carry++) {
+                for (int a = 0; a < 256; a++) {
+                    for (int b = 0; b < 256; b++) {
+                        reg.A  = a;
+                        reg.B  = b;
+                        reg.SP = Machine::STACK;
+
+                        if (lazy_carry) {
+                            reg.D = carry ? 0x80 : 0x00;
+                            reg.load_flags(0xF0);
+                            m.run({0xCB, 0x12, opcode, 0xF5}, 3);  // RL D, op, PUSH AF
+                        } else {
+                            reg.load_flags(carry ? 0x10 : 0x00);
+                            m.run({opcode, 0xF5}, 2);
+                        }
+
+                        Eager       want   = eager_alu(op, a, b, carry);
+                        u8          pushed = m.emu->mmu.read_u8(Machine::STACK - 2);
+                        std::string what   = std::string(ALU_NAMES[op]) + " A=" + hex(a) + " B=" + hex(b) +
+                                           " carry=" + std::to_string(carry) + (lazy_carry ? " (lazy)" : "");
+
+                        check(reg.A == want.a, what + ": A=" + hex(reg.A) + ", expected " + hex(want.a));
+                        check(reg.flags() == want.f(), what + ": F=" + hex(reg.flags()) + ", expected " + hex(want.f()));
+                        check(pushed == want.f(), what + ": pushed F=" + hex(pushed) + ", expected " + hex(want.f()));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// INC and DEC keep C, whatever state it was left in
+void test_inc_dec_flags(Machine& m) {
+    Registers& reg = m.emu->cpu.reg;
+
+    for (int dec = 0; dec < 2; dec++) {
+        for (int f = 0; f < 16; f++) {
+            for (int v = 0; v < 256; v++) {
+                reg.B = v;
+                reg.load_flags(f << 4);
+                m.run({u8(dec ? 0x05 : 0x04)}, 1);
+
+                u8   res  = dec ? v - 1 : v + 1;
+                bool h    = dec ? (v & 0x0F) == 0x00 : (v & 0x0F) == 0x0F;
+                u8   want = ((res == 0) << 7) | (dec << 6) | (h << 5) | (f & 0x1) << 4;
+
+                check(reg.B == res && reg.flags() == want, std::string(dec ? "DEC" : "INC") + " B=" + hex(v) +
+                                                               " F=" + hex(f << 4) + ": F=" + hex(reg.flags()) +
+                                                               ", expected " + hex(want));
+            }
+        }
+    }
+}
+
+// DAA on every A with every F loaded directly, and right after ADD, ADC, SUB
+// and SBC so that N, H and C come from lazy state
+void test_daa_flags(Machine& m) {
+    Registers& reg = m.emu->cpu.reg;
+
+    for (int f = 0; f < 16; f++) {
+        for (int a = 0; a < 256; a++) {
+            reg.A = a;
+            reg.load_flags(f << 4);
+            m.run({0x27}, 1);
+
+            Eager want = eager_daa(a, f & 0x4, f & 0x2, f & 0x1);
+            check(reg.A == want.a && reg.flags() == want.f(),
+                  "DAA A=" + hex(a) + " F=" + hex(f << 4) + ": A=" + hex(reg.A) + " F=" + hex(reg.flags()) +
+                      ", expected A=" + hex(want.a) + " F=" + hex(want.f()));
+        }
+    }
+
+    for (int op = 0; op < 4; op++) {
+        for (int a = 0; a < 256; a++) {
+            for (int b = 0; b < 256; b += 3) {
+                reg.A = a;
+                reg.B = b;
+                reg.load_flags(0x10);
+                m.run({u8(0x80 | (op << 3)), 0x27}, 2);
+
+                Eager before = eager_alu(op, a, b, true);
+                Eager want   = eager_daa(before.a, before.n, before.h, before.c);
+                check(reg.A == want.a && reg.flags() == want.f(),
+                      std::string(ALU_NAMES[op]) + " A=" + hex(a) + " B=" + hex(b) + ", DAA: A=" + hex(reg.A) +
+                          " F=" + hex(reg.flags()) + ", expected A=" + hex(want.a) + " F=" + hex(want.f()));
+            }
+        }
+    }
+}
+
+// ADD SP,e8 and LD HL,SP+e8 carry out of bits 3 and 7 of the low byte
+void test_sp_offset_flags(Machine& m) {
+    Registers& reg = m.emu->cpu.reg;
+
+    for (int high : {0x00, 0x7F, 0xD0, 0xFF}) {
+        for (int low = 0; low < 256; low++) {
+            for (int e = 0; e < 256; e++) {
+                u16  sp   = (high << 8) | low;
+                u16  res  = sp + static_cast<i8>(e);
+                bool h    = (sp & 0x0F) + (e & 0x0F) > 0x0F;
+                bool c    = (sp & 0xFF) + (e & 0xFF) > 0xFF;
+                u8   want = (h << 5) | (c << 4);
+
+                reg.SP = sp;
+                reg.load_flags(0xF0);
+                m.run({0xE8, u8(e)}, 1);
+                check(reg.SP == res && reg.flags() == want, "ADD SP," + hex(e) + " SP=" + hex(sp >> 8) +
+                                                                hex(sp & 0xFF) + ": F=" + hex(reg.flags()) +
+                                                                ", expected " + hex(want));
+
+                reg.SP = sp;
+                reg.load_flags(0xF0);
+                m.run({0xF8, u8(e)}, 1);
+                check(reg.HL == res && reg.flags() == want, "LD HL,SP+" + hex(e) + " SP=" + hex(sp >> 8) +
+                                                                hex(sp & 0xFF) + ": F=" + hex(reg.flags()) +
+                                                                ", expected " + hex(want));
+            }
+        }
+    }
+}
+
+// =============================================================
+//  Opcode tables
+// =============================================================
+
+// Cycles of each opcode when no branch is taken, as the hand-written tables
+// had them. Unused opcodes have none.
+const u8 CYCLES[256] = {
+    4,  12, 8,  8,  4,  4,  8,  4,  20, 8,  8,  8,  4,  4,  8,  4,  // 0x
+    4,  12, 8,  8,  4,  4,  8,  4,  12, 8,  8,  8,  4,  4,  8,  4,  // 1x
+    8,  12, 8,  8,  4,  4,  8,  4,  8,  8,  8,  8,  4,  4,  8,  4,  // 2x
+    8,  12, 8,  8,  12, 12, 12, 4,  8,  8,  8,  8,  4,  4,  8,  4,  // 3x
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // 4x
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // 5x
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // 6x
+    8,  8,  8,  8,  8,  8,  4,  8,  4,  4,  4,  4,  4,  4,  8,  4,  // 7x
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // 8x
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // 9x
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // Ax
+    4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4,  // Bx
+    8,  12, 12, 16, 12, 16, 8,  16, 8,  16, 12, 4,  12, 24, 8,  16,  // Cx
+    8,  12, 12, 0,  12, 16, 8,  16, 8,  16, 12, 0,  12, 0,  8,  16,  // Dx
+    12, 12, 8,  0,  0,  16, 8,  16, 16, 4,  16, 0,  0,  0,  8,  16,  // Ex
+    12, 12, 8,  4,  0,  16, 8,  16, 12, 8,  16, 4,  0,  0,  8,  16,  // Fx
+};
+
+const u8 LENGTHS[256] = {
+    1, 3, 1, 1, 1, 1, 2, 1, 3, 1, 1, 1, 1, 1, 2, 1,  // 0x
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,  // 1x
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,  // 2x
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,  // 3x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 4x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 5x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 6x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 7x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 8x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 9x
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // Ax
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // Bx
+    1, 1, 3, 3, 3, 1, 2, 1, 1, 1, 3, 1, 3, 3, 2, 1,  // Cx
+    1, 1, 3, 1, 3, 1, 2, 1, 1, 1, 3, 1, 3, 1, 2, 1,  // Dx
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1,  // Ex
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1,  // Fx
+};
+
+void test_opcode_tables() {
+    for (int op = 0; op < 256; op++) {
+        const Instruction& inst = Cpu::instructions[op];
+        check(inst.cycles == CYCLES[op] && inst.length == LENGTHS[op],
+              "opcode " + hex(op) + " (" + inst.name + "): " + std::to_string(inst.cycles) + " cycles, " +
+                  std::to_string(inst.length) + " bytes, expected " + std::to_string(CYCLES[op]) + ", " +
+                  std::to_string(LENGTHS[op]));
+
+        // CB ops touching (HL) take 16 cycles, 12 for BIT, the rest 8
+        const Instruction& cb     = Cpu::cb_instructions[op];
+        int                cycles = (op & 7) != 6 ? 8 : (op >= 0x40 && op < 0x80) ? 12 : 16;
+        check(cb.cycles == cycles && cb.length == 2, "CB " + hex(op) + " (" + cb.name +
+                                                         "): " + std::to_string(cb.cycles) + " cycles, expected " +
+                                                         std::to_string(cycles));
+    }
+}
+
+// The generated 8-bit loads and ALU ops pick the right registers: every
+// LD r,r' and every ALU op on every source register
+void test_register_operands(Machine& m) {
+    Registers& reg = m.emu->cpu.reg;
+
+    // Operand order in the encoding: B, C, D, E, H, L, (HL), A
+    auto set = [&](int i, u8 v) {
+        switch (i) {
+            case 0: reg.B = v; break;
+            case 1: reg.C = v; break;
+            case 2: reg.D = v; break;
+            case 3: reg.E = v; break;
+            case 4: reg.H = v; break;
+            case 5: reg.L = v; break;
+            case 6: m.emu->mmu.write_u8(reg.HL, v); break;
+            case 7: reg.A = v; break;
+        }
+    };
+    auto get = [&](int i) -> u8 {
+        switch (i) {
+            case 0: return reg.B;
+            case 1: return reg.C;
+            case 2: return reg.D;
+            case 3: return reg.E;
+            case 4: return reg.H;
+            case 5: return reg.L;
+            case 6: return m.emu->mmu.read_u8(reg.HL);
+            default: return reg.A;
+        }
+    };
+    auto reset = [&] {
+        reg.HL = 0xC180;
+        for (int i = 0; i < 8; i++) {
+            if (i != 4 && i != 5) set(i, 0x11 * (i + 1));
+        }
+    };
+
+    for (int op = 0x40; op < 0xC0; op++) {
+        if (op == 0x76) continue;  // HALT
+
+        int dst = (op >> 3) & 7;
+        int src = op & 7;
+
+        reset();
+        u8 value = get(src);
+        u8 a     = reg.A;
+        reg.load_flags(0x00);
+        m.run({u8(op)}, 1);
+
+        if (op < 0x80) {
+            check(get(dst) == value, "opcode " + hex(op) + ": dest=" + hex(get(dst)) + ", expected " + hex(value));
+        } else {
+            Eager want = eager_alu(dst, a, value, false);
+            check(reg.A == want.a && reg.flags() == want.f(),
+                  std::string(ALU_NAMES[dst]) + " opcode " + hex(op) + ": A=" + hex(reg.A) + " F=" +
+                      hex(reg.flags()) + ", expected A=" + hex(want.a) + " F=" + hex(want.f()));
+        }
+    }
+}
+
+// =============================================================
+//  Timer
+// =============================================================
+
+// The timer as it was before it caught up lazily: ticked after every
+// instruction, here every 4 cycles
+struct EagerTimer {
+    u16  counter      = 0;
+    int  tima_counter = 0;
+    u8   tima         = 0;
+    u8   tma          = 0;
+    u8   tac          = 0;
+    bool overflowed   = false;
+
+    u8 div() const { return counter >> 8; }
+
+    void tick(int cycles) {
+        counter += cycles;
+        if ((tac & 0x04) == 0) return;
+
+        static constexpr int thresholds[4] = {1024, 16, 64, 256};
+        tima_counter += cycles;
+        while (tima_counter >= thresholds[tac & 3]) {
+            tima_counter -= thresholds[tac & 3];
+            if (++tima == 0) {
+                tima       = tma;
+                overflowed = true;
+            }
+        }
+    }
+};
+
+// Random gaps between looks at the timer, from one instruction to several
+// hundred overflows, with TMA, TIMA and TAC rewritten along the way. The
+// timer event has to be due exactly when the eager timer overflowed.
+void test_timer(const std::string& rom) {
+    std::mt19937 rng(2);
+
+    for (int run = 0; run < 64; run++) {
+        Machine    m(rom);
+        Emulator&  emu = *m.emu;
+        EagerTimer eager;
+
+        u8 tma  = run % 4 == 0 ? 0xFF : run % 4 == 1 ? 0x00 : u8(rng());
+        u8 tac  = 0x04 | (run & 3);
+        u8 tima = rng();
+
+        emu.mmu.write_u8(0xFF04, 0);
+        emu.mmu.write_u8(0xFF0F, 0);
+        emu.mmu.write_u8(0xFF06, tma);
+        emu.mmu.write_u8(0xFF05, tima);
+        emu.mmu.write_u8(0xFF07, tac);
+        eager.tma  = tma;
+        eager.tima = tima;
+        eager.tac  = tac;
+
+        for (int step = 0; step < 400; step++) {
+            int kind = rng() % 16;
+            u64 gap  = kind < 10 ? 4 * (1 + rng() % 8) : kind < 15 ? 4 * (rng() % 4096) : 4 * (rng() % 100000);
+
+            for (u64 i = 0; i < gap; i += 4) {
+                eager.tick(4);
+            }
+            emu.scheduler.now += gap;
+
+            std::string what = "timer run " + std::to_string(run) + " step " + std::to_string(step) +
+                               " TAC=" + hex(eager.tac) + " TMA=" + hex(eager.tma);
+
+            check(emu.scheduler.is_due(Event::Timer) == eager.overflowed,
+                  what + ": overflow due=" + std::to_string(emu.scheduler.is_due(Event::Timer)) + ", expected " +
+                      std::to_string(eager.overflowed));
+
+            u8 got_tima = emu.mmu.read_u8(0xFF05);
+            u8 got_div  = emu.mmu.read_u8(0xFF04);
+            u8 got_if   = emu.mmu.read_u8(0xFF0F) & 0x04;
+            check(got_tima == eager.tima, what + ": TIMA=" + hex(got_tima) + ", expected " + hex(eager.tima));
+            check(got_div == eager.div(), what + ": DIV=" + hex(got_div) + ", expected " + hex(eager.div()));
+            check((got_if != 0) == eager.overflowed, what + ": IF timer bit wrong");
+
+            emu.mmu.write_u8(0xFF0F, 0);
+            eager.overflowed = false;
+
+            switch (rng() % 8) {
+                case 0:
+                    eager.tma = rng();
+                    emu.mmu.write_u8(0xFF06, eager.tma);
+                    break;
+                case 1:
+                    eager.tima = rng();
+                    emu.mmu.write_u8(0xFF05, eager.tima);
+                    break;
+                case 2:
+                    eager.tac = 0x04 | (rng() & 3);
+                    emu.mmu.write_u8(0xFF07, eager.tac);
+                    break;
+            }
+        }
+    }
+}
+
+// =============================================================
+//  Mappers
+// =============================================================
+
+struct BankCase {
+    const char* mapper;
+    u8          type;
+    u16         addr;  // Bank register
+    u8          val;
+    int         bank;  // Expected at 0x4000 with 8 banks
+};
+
+// Bank numbers past the ROM wrap around, 0 means 1 where the mapper says so
+const BankCase BANK_CASES[] = {
+    {"MBC1", 0x01, 0x2000, 0x00, 1}, {"MBC1", 0x01, 0x2000, 0x05, 5}, {"MBC1", 0x01, 0x2000, 0x0D, 5},
+    {"MBC1", 0x01, 0x2000, 0x08, 0}, {"MBC1", 0x01, 0x2000, 0x10, 0}, {"MBC1", 0x01, 0x2000, 0x20, 1},
+    {"MBC2", 0x05, 0x2100, 0x00, 1}, {"MBC2", 0x05, 0x2100, 0x0F, 7}, {"MBC2", 0x05, 0x2100, 0x10, 1},
+    {"MBC2", 0x05, 0x2000, 0x03, 1}, {"MBC3", 0x11, 0x2000, 0x00, 1}, {"MBC3", 0x11, 0x2000, 0x7E, 6},
+    {"MBC3", 0x11, 0x2000, 0x40, 0}, {"MBC3", 0x11, 0x2000, 0x80, 1}, {"MBC5", 0x19, 0x2000, 0x00, 0},
+    {"MBC5", 0x19, 0x2000, 0x0B, 3}, {"MBC5", 0x19, 0x2000, 0x07, 7}, {"MBC5", 0x19, 0x3000, 0x01, 1},
+    {"HuC1", 0xFF, 0x2000, 0x00, 1}, {"HuC1", 0xFF, 0x2000, 0x3A, 2}, {"HuC1", 0xFF, 0x2000, 0x40, 1},
+};
+
+void test_bank_masking() {
+    for (const BankCase& t : BANK_CASES) {
+        Machine m(make_rom(t.mapper, t.type, 8));
+        m.emu->mmu.write_u8(t.addr, t.val);
+
+        int bank = m.emu->mmu.read_u8(0x4000);
+        check(bank == t.bank, std::string(t.mapper) + " " + hex(t.addr >> 8) + hex(t.addr & 0xFF) + "=" +
+                                  hex(t.val) + ": bank " + std::to_string(bank) + ", expected " +
+                                  std::to_string(t.bank));
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::string rom = make_rom("plain", 0x00, 2);
+
+    struct Test {
+        const char*           name;
+        std::function<void()> run;
+    };
+
+    Machine    m(rom);
+    const Test tests[] = {
+        {"ALU flags", [&] { test_alu_flags(m); }},
+        {"INC/DEC flags", [&] { test_inc_dec_flags(m); }},
+        {"DAA flags", [&] { test_daa_flags(m); }},
+        {"SP+e8 flags", [&] { test_sp_offset_flags(m); }},
+        {"opcode tables", [] { test_opcode_tables(); }},
+        {"register operands", [&] { test_register_operands(m); }},
+        {"timer", [&] { test_timer(rom); }},
+        {"bank masking", [] { test_bank_masking(); }},
+    };
+
+    for (const Test& t : tests) {
+        int before = failures;
+        t.run();
+        std::cout << (failures == before ? "ok   " : "FAIL ") << t.name << std::endl;
+    }
+
+    std::cout << checks - failures << "/" << checks << " checks passed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -7,6 +7,14 @@ option("profile_trace")
     set_default(false)
     set_showmenu(true)
 
+option("switch_core")
+    set_default(false)
+    set_showmenu(true)
+
+option("rtc_wall_clock")
+    set_default(false)
+    set_showmenu(true)
+
 target("tracy_client")
     set_kind("static")
     set_languages("c++17")
@@ -44,6 +52,46 @@ target("bboy2")
         add_deps("tracy_client")
     end
 
+    if get_config("switch_core") then
+        add_defines("SWITCH_CORE")
+    end
+
+    if get_config("rtc_wall_clock") then
+        add_defines("RTC_WALL_CLOCK")
+    end
+
+    if is_plat("windows") then
+        add_syslinks("user32", "gdi32", "winmm", "shell32")
+    end
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+target("core_tests")
+    set_kind("binary")
+    set_languages("c++17")
+    set_default(false)
+
+    add_files("tests/*.cpp")
+    add_files("src/emulator/**.cpp|ppu/screen.cpp")
+    add_includedirs("src")
+
+    add_includedirs("tracy/public")
+
+    add_includedirs("libs/include")
+    add_linkdirs("libs/lib")
+    add_links("raylib")
+
+    set_pcxxheader("src/project_types.h")
+
+    if get_config("switch_core") then
+        add_defines("SWITCH_CORE")
+    end
+
     if is_plat("windows") then
         add_syslinks("user32", "gdi32", "winmm", "shell32")
-    end
\ No newline at end of file
+    end
+
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end